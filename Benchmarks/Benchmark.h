@@ -0,0 +1,108 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Minimal in-tree benchmark harness used by `tombstone-bench`.
+ *
+ * Benchmarks are registered with `TOMBSTONE_BENCHMARK(name)` and receive a `bench::State`.
+ * The body runs `while (state.keepRunning())` and reports how many items (objects, rects, ...)
+ * one iteration processed, so the results can be compared as items/sec.
+ */
+namespace bench {
+    class State {
+    public:
+        explicit State(double minTime) : m_minTime(minTime) {}
+
+        bool keepRunning() {
+            using clock = std::chrono::steady_clock;
+
+            if (m_iterations == 0) {
+                m_start = clock::now();
+            }
+
+            if ((m_iterations & (m_checkInterval - 1)) == 0 && m_iterations != 0) {
+                m_elapsed = std::chrono::duration<double>(clock::now() - m_start).count();
+
+                if (m_elapsed >= m_minTime) {
+                    return false;
+                }
+            }
+
+            ++m_iterations;
+            return true;
+        }
+
+        /**
+         * Number of items processed by one iteration. Used to report throughput.
+         */
+        void setItemsPerIteration(uint64_t items) { m_itemsPerIteration = items; }
+
+        /**
+         * Makes `keepRunning` check the clock only every `n` iterations. `n` must be a power of two.
+         */
+        void setCheckInterval(uint64_t n) { m_checkInterval = n; }
+
+        void skip(std::string_view reason) { m_skipReason = reason; }
+
+        /**
+         * Extra text printed after the results, e.g. which SIMD kernel was compiled in.
+         */
+        void setLabel(std::string_view label) { m_label = label; }
+
+        uint64_t getIterations() const { return m_iterations; }
+        uint64_t getItemsPerIteration() const { return m_itemsPerIteration; }
+        double getElapsed() const { return m_elapsed; }
+        const std::string& getSkipReason() const { return m_skipReason; }
+        const std::string& getLabel() const { return m_label; }
+
+    private:
+        double m_minTime;
+        double m_elapsed = 0;
+        uint64_t m_iterations = 0;
+        uint64_t m_itemsPerIteration = 0;
+        uint64_t m_checkInterval = 1;
+        std::string m_skipReason;
+        std::string m_label;
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+    using BenchmarkFunc = void (*)(State&);
+
+    struct Registration {
+        Registration(const char* name, BenchmarkFunc func);
+    };
+
+    struct Entry {
+        std::string name;
+        BenchmarkFunc func;
+    };
+
+    std::vector<Entry>& registry();
+
+    /**
+     * Reads a file from the content folder (`Content/` by default, see `--content`).
+     * Returns an empty string if the file doesn't exist.
+     */
+    std::string readContentFile(std::string_view path);
+
+    template <typename T>
+    inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+}
+
+#define TOMBSTONE_BENCHMARK(name)                                                     \
+    static void name(bench::State&);                                                  \
+    static bench::Registration name##_registration(#name, &name);                     \
+    static void name(bench::State& state)
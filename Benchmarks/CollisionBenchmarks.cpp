@@ -0,0 +1,195 @@
+#include "Benchmark.h"
+#include "LevelFixture.h"
+
+#include "Utils/RectOverlap.inl.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace {
+    /**
+     * Same layout and test as `ax::Rect`: origin plus size, max edges computed on every call.
+     */
+    struct EngineRect {
+        float x, y, width, height;
+
+        float getMinX() const { return x; }
+        float getMinY() const { return y; }
+        float getMaxX() const { return x + width; }
+        float getMaxY() const { return y + height; }
+
+        bool intersectsRect(const EngineRect& rect) const {
+            return !(getMaxX() < rect.getMinX() || rect.getMaxX() < getMinX() || getMaxY() < rect.getMinY() ||
+                     rect.getMaxY() < getMinY());
+        }
+    };
+
+    constexpr size_t SUBSTEPS_PER_ITERATION = 64;
+
+    /**
+     * Number of rect tests one iteration does: the three sections around the player for every substep.
+     */
+    uint64_t countTests(const bench::LevelFixture& fixture) {
+        uint64_t tests = 0;
+
+        for (size_t step = 0; step < SUBSTEPS_PER_ITERATION; step++) {
+            int section = level_format::section_for_x(fixture.playerRect(step).minX + 15);
+
+            for (int i = section - 1; i <= section + 1; i++) {
+                if (i >= 0 && static_cast<size_t>(i) < fixture.sections.size()) {
+                    tests += fixture.sections[i].size();
+                }
+            }
+        }
+
+        return tests;
+    }
+
+    template <typename Sweep>
+    void runSweep(bench::State& state, Sweep&& sweep) {
+        const bench::LevelFixture& fixture = bench::levelFixture();
+
+        if (fixture.empty()) {
+            return state.skip("tombstone/level.txt not found");
+        }
+
+        state.setItemsPerIteration(countTests(fixture));
+
+        size_t firstStep = 0;
+
+        while (state.keepRunning()) {
+            for (size_t step = firstStep; step < firstStep + SUBSTEPS_PER_ITERATION; step++) {
+                CollisionRect player = fixture.playerRect(step);
+                int section          = level_format::section_for_x(player.minX + 15);
+
+                for (int i = section - 1; i <= section + 1; i++) {
+                    if (i >= 0 && static_cast<size_t>(i) < fixture.sections.size()) {
+                        sweep(i, player);
+                    }
+                }
+            }
+
+            // Walk through the level instead of hammering the same few sections.
+            firstStep = (firstStep + SUBSTEPS_PER_ITERATION) % (fixture.sections.size() * 40);
+        }
+    }
+}
+
+TOMBSTONE_BENCHMARK(Collision_EngineRectIntersects) {
+    const bench::LevelFixture& fixture = bench::levelFixture();
+
+    // What checkCollisions did before the SoA arrays: one rect per object, tested one at a time.
+    std::vector<std::vector<EngineRect>> sections(fixture.sections.size());
+
+    for (size_t i = 0; i < fixture.sections.size(); i++) {
+        for (size_t j = 0; j < fixture.sections[i].size(); j++) {
+            CollisionRect rect = fixture.sections[i].getRect(j);
+            sections[i].push_back({rect.minX, rect.minY, rect.maxX - rect.minX, rect.maxY - rect.minY});
+        }
+    }
+
+    runSweep(state, [&sections](int section, const CollisionRect& player) {
+        EngineRect playerRect {player.minX, player.minY, player.maxX - player.minX, player.maxY - player.minY};
+        unsigned hits = 0;
+
+        for (const EngineRect& rect : sections[section]) {
+            hits += playerRect.intersectsRect(rect);
+        }
+
+        bench::doNotOptimize(hits);
+    });
+}
+
+TOMBSTONE_BENCHMARK(Collision_OverlapMaskScalar) {
+    const bench::LevelFixture& fixture = bench::levelFixture();
+    std::vector<uint8_t> mask;
+
+    runSweep(state, [&fixture, &mask](int section, const CollisionRect& player) {
+        const CollisionSection& collision = fixture.sections[section];
+        mask.resize(collision.size());
+
+        rect_overlap::overlap_mask_scalar(collision.getMinX(), collision.getMinY(), collision.getMaxX(),
+                                          collision.getMaxY(), collision.size(), player, mask.data());
+        bench::doNotOptimize(mask.data());
+    });
+}
+
+TOMBSTONE_BENCHMARK(Collision_OverlapMask) {
+    const bench::LevelFixture& fixture = bench::levelFixture();
+    std::vector<uint8_t> mask;
+
+    state.setLabel(rect_overlap::kernel_name());
+
+    runSweep(state, [&fixture, &mask](int section, const CollisionRect& player) {
+        const CollisionSection& collision = fixture.sections[section];
+        mask.resize(collision.size());
+
+        rect_overlap::overlap_mask(collision, 0, player, mask.data());
+        bench::doNotOptimize(mask.data());
+    });
+}
+
+TOMBSTONE_BENCHMARK(Collision_SweptAABB) {
+    const bench::LevelFixture& fixture = bench::levelFixture();
+
+    if (fixture.empty()) {
+        return state.skip("tombstone/level.txt not found");
+    }
+
+    // `CollisionMode::Swept`: one test per 60 Hz frame covering what four substeps would, the broad
+    // phase on the swept bounds and the exact swept test on whatever it finds.
+    constexpr size_t STEPS_PER_FRAME = 4;
+
+    auto sectionsFor = [&fixture](const CollisionRect& bounds) {
+        return std::pair {std::max(level_format::section_for_x(bounds.minX + 15) - 1, 0),
+                          std::min(level_format::section_for_x(bounds.maxX - 15) + 1,
+                                   static_cast<int>(fixture.sections.size()) - 1)};
+    };
+
+    uint64_t tests = 0;
+
+    for (size_t step = 0; step < SUBSTEPS_PER_ITERATION; step += STEPS_PER_FRAME) {
+        auto [first, last] = sectionsFor(
+            rect_overlap::sweep_bounds(fixture.playerRect(step), fixture.playerRect(step + STEPS_PER_FRAME)));
+
+        for (int i = first; i <= last; i++) {
+            tests += fixture.sections[i].size();
+        }
+    }
+
+    state.setItemsPerIteration(tests);
+
+    std::vector<uint8_t> mask;
+    size_t firstStep = 0;
+
+    while (state.keepRunning()) {
+        unsigned hits = 0;
+
+        for (size_t step = firstStep; step < firstStep + SUBSTEPS_PER_ITERATION; step += STEPS_PER_FRAME) {
+            CollisionRect from   = fixture.playerRect(step);
+            CollisionRect to     = fixture.playerRect(step + STEPS_PER_FRAME);
+            CollisionRect bounds = rect_overlap::sweep_bounds(from, to);
+            auto [first, last]   = sectionsFor(bounds);
+
+            for (int i = first; i <= last; i++) {
+                const CollisionSection& collision = fixture.sections[i];
+                mask.resize(collision.size());
+                rect_overlap::overlap_mask(collision, 0, bounds, mask.data());
+
+                for (size_t j = 0; j < collision.size(); j++) {
+                    float toi;
+
+                    if (mask[j] && rect_overlap::sweep_intersects(from, to.minX - from.minX, to.minY - from.minY,
+                                                                  collision.getRect(j), toi))
+                    {
+                        hits++;
+                    }
+                }
+            }
+        }
+
+        bench::doNotOptimize(hits);
+        firstStep = (firstStep + SUBSTEPS_PER_ITERATION) % (fixture.sections.size() * 40);
+    }
+}
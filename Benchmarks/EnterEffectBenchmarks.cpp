@@ -0,0 +1,197 @@
+#include "Benchmark.h"
+#include "LevelFixture.h"
+
+#include "Utils/EnterEffect.inl.h"
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr float HALF_SCREEN_WIDTH = 284.0f; ///< 16:9 at the 320 unit design height.
+    constexpr size_t CAMERA_STOPS     = 32;
+
+    /**
+     * X of every object `PlayScene::updateVisibility` looks at, for `CAMERA_STOPS` camera positions
+     * spread over the level: the sections from one screen width left of the camera to two right.
+     */
+    struct VisibleObjects {
+        std::vector<float> cameraX;
+        std::vector<std::vector<float>> objectX;
+        size_t count = 0;
+    };
+
+    const VisibleObjects& visibleObjects() {
+        static const VisibleObjects visible = [] {
+            const bench::LevelFixture& fixture = bench::levelFixture();
+            VisibleObjects visible;
+
+            if (fixture.empty()) {
+                return visible;
+            }
+
+            float levelWidth = fixture.sections.size() * level_format::SECTION_WIDTH;
+
+            for (size_t stop = 0; stop < CAMERA_STOPS; stop++) {
+                float cameraX = levelWidth * stop / CAMERA_STOPS;
+                int first     = level_format::section_for_x(cameraX - HALF_SCREEN_WIDTH * 2);
+                int last      = level_format::section_for_x(cameraX + HALF_SCREEN_WIDTH * 4);
+
+                visible.cameraX.push_back(cameraX);
+                visible.objectX.emplace_back();
+
+                for (int i = std::max(first, 0); i <= last && i < static_cast<int>(fixture.sections.size()); i++) {
+                    const CollisionSection& section = fixture.sections[i];
+
+                    for (size_t j = 0; j < section.size(); j++) {
+                        visible.objectX.back().push_back((section.getMinX()[j] + section.getMaxX()[j]) / 2);
+                    }
+                }
+
+                visible.count += visible.objectX.back().size();
+            }
+
+            return visible;
+        }();
+
+        return visible;
+    }
+}
+
+TOMBSTONE_BENCHMARK(EnterEffect_RelativeMod) {
+    const VisibleObjects& visible = visibleObjects();
+
+    if (visible.count == 0) {
+        return state.skip("tombstone/level.txt not found");
+    }
+
+    state.setItemsPerIteration(visible.count);
+
+    while (state.keepRunning()) {
+        float sum = 0;
+
+        for (size_t stop = 0; stop < CAMERA_STOPS; stop++) {
+            for (float x : visible.objectX[stop]) {
+                sum += enter_effect::relative_mod(x, visible.cameraX[stop], HALF_SCREEN_WIDTH, 70, 70, 0);
+            }
+        }
+
+        bench::doNotOptimize(sum);
+    }
+}
+
+TOMBSTONE_BENCHMARK(EnterEffect_Transform) {
+    const VisibleObjects& visible = visibleObjects();
+
+    if (visible.count == 0) {
+        return state.skip("tombstone/level.txt not found");
+    }
+
+    state.setItemsPerIteration(visible.count);
+
+    // Opacity and enter effect one object at a time, every effect in turn.
+    while (state.keepRunning()) {
+        float sum  = 0;
+        int effect = 0;
+
+        for (size_t stop = 0; stop < CAMERA_STOPS; stop++) {
+            for (float x : visible.objectX[stop]) {
+                float opacity = enter_effect::relative_mod(x, visible.cameraX[stop], HALF_SCREEN_WIDTH, 70, 70, 0);
+                float mod     = enter_effect::relative_mod(x, visible.cameraX[stop], HALF_SCREEN_WIDTH, 60, 60, 0);
+
+                effect = (effect == 12) ? 1 : effect + 1;
+                enter_effect::Transform transform = enter_effect::transform(effect, mod, 45);
+                sum += opacity + transform.offsetX + transform.offsetY + transform.scale;
+            }
+        }
+
+        bench::doNotOptimize(sum);
+    }
+}
+
+namespace {
+    /**
+     * Whether `run` gives bit-identical outputs to `run_scalar` for the inputs of `batch`.
+     */
+    bool matchesScalar(const enter_effect::Batch& batch, float cameraX) {
+        enter_effect::Batch simd = batch;
+        enter_effect::Batch scalar = batch;
+
+        enter_effect::run(simd, cameraX, HALF_SCREEN_WIDTH);
+        enter_effect::run_scalar(scalar, 0, cameraX, HALF_SCREEN_WIDTH);
+
+        auto same = [&](const std::vector<float>& a, const std::vector<float>& b) {
+            return std::memcmp(a.data(), b.data(), batch.size() * sizeof(float)) == 0;
+        };
+
+        return same(simd.opacity, scalar.opacity) && same(simd.relativeMod, scalar.relativeMod) &&
+               same(simd.offsetX, scalar.offsetX) && same(simd.offsetY, scalar.offsetY) &&
+               same(simd.scale, scalar.scale);
+    }
+
+    /**
+     * `matchesScalar` for random objects around the screen with every effect, angle and opacity offset.
+     */
+    bool randomMatchesScalar(size_t objects) {
+        std::mt19937 random(20);
+        std::uniform_real_distribution<float> x(-200, 800), angle(-180, 180), offset(0, 40);
+        std::uniform_int_distribution<int> effect(0, 12);
+
+        enter_effect::Batch batch;
+
+        for (size_t i = 0; i < objects; i++) {
+            batch.add(x(random), offset(random), enter_effect::coefficients(effect(random), angle(random)));
+        }
+
+        return matchesScalar(batch, 0);
+    }
+}
+
+TOMBSTONE_BENCHMARK(EnterEffect_Batch) {
+    const VisibleObjects& visible = visibleObjects();
+
+    if (visible.count == 0) {
+        return state.skip("tombstone/level.txt not found");
+    }
+
+    // Objects are added when they become active and keep their entry, see `PlayScene::queueEnterEffect`.
+    std::vector<enter_effect::Batch> batches(CAMERA_STOPS);
+    bool matches = randomMatchesScalar(100000);
+
+    for (size_t stop = 0; stop < CAMERA_STOPS; stop++) {
+        int effect = 0;
+
+        for (float x : visible.objectX[stop]) {
+            effect = (effect == 12) ? 1 : effect + 1;
+            batches[stop].add(x, 0, enter_effect::coefficients(effect, 45));
+        }
+
+        matches = matches && matchesScalar(batches[stop], visible.cameraX[stop]);
+    }
+
+    state.setItemsPerIteration(visible.count);
+    state.setLabel(std::string(enter_effect::kernel_name()) + (matches ? ", matches run_scalar" : ", MISMATCH with run_scalar"));
+
+    // Same work as EnterEffect_Transform, the way `updateVisibility` does it: the opacity offset is
+    // the one input that is written every frame, then run and read back.
+    while (state.keepRunning()) {
+        float sum = 0;
+
+        for (size_t stop = 0; stop < CAMERA_STOPS; stop++) {
+            enter_effect::Batch& batch = batches[stop];
+
+            for (size_t i = 0; i < batch.size(); i++) {
+                batch.opacityOffset[i] = 0;
+            }
+
+            enter_effect::run(batch, visible.cameraX[stop], HALF_SCREEN_WIDTH);
+
+            for (size_t i = 0; i < batch.size(); i++) {
+                sum += batch.opacity[i] + batch.offsetX[i] + batch.offsetY[i] + batch.scale[i];
+            }
+        }
+
+        bench::doNotOptimize(sum);
+    }
+}
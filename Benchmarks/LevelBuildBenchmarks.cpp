@@ -0,0 +1,94 @@
+#include "Benchmark.h"
+#include "LevelFixture.h"
+
+#include "Objects/HazardIndex.h"
+#include "Objects/SpatialGrid.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace {
+    /**
+     * Stand-in for a spawned `GameObject`: the sort only reads the spawn X, but through a pointer to
+     * an object of about the same size, scattered over the heap like nodes are.
+     */
+    struct SpawnObject {
+        float spawnX;
+        char payload[1020];
+    };
+}
+
+TOMBSTONE_BENCHMARK(LevelBuild_AddToSection) {
+    const bench::LevelFixture& fixture = bench::levelFixture();
+
+    if (fixture.empty()) {
+        return state.skip("tombstone/level.txt not found");
+    }
+
+    state.setItemsPerIteration(fixture.objects.size());
+
+    // `PlayScene::addToSection` without the nodes: section list, 2D grid and hazard index.
+    while (state.keepRunning()) {
+        std::vector<std::vector<uint32_t>> sections;
+        SpatialGrid<uint32_t> grid(100, 100);
+        HazardIndex hazards;
+
+        for (uint32_t i = 0; i < fixture.objects.size(); i++) {
+            const bench::FixtureObject& object = fixture.objects[i];
+            size_t section = static_cast<size_t>(std::max(level_format::section_for_x(object.rect.minX + 15), 0));
+
+            if (sections.size() <= section) {
+                sections.resize(section + 1);
+                hazards.resize(section + 1);
+            }
+
+            sections[section].push_back(i);
+            grid.insert(i, object.rect, object.type, object.flags);
+
+            if (object.type == GameObjectType::Hazard) {
+                hazards.add(static_cast<int>(section), object.rect);
+            }
+        }
+
+        bench::doNotOptimize(grid.size());
+    }
+}
+
+TOMBSTONE_BENCHMARK(LevelBuild_SpawnQueueSort) {
+    const bench::LevelFixture& fixture = bench::levelFixture();
+
+    if (fixture.empty()) {
+        return state.skip("tombstone/level.txt not found");
+    }
+
+    // Levels without triggers sort every object's X instead, so there is something to measure.
+    std::vector<float> spawnXs = fixture.spawnXs;
+
+    if (spawnXs.empty()) {
+        for (const bench::FixtureObject& object : fixture.objects) {
+            spawnXs.push_back(object.rect.minX + 15);
+        }
+
+        state.setLabel("all objects");
+    }
+
+    std::vector<std::unique_ptr<SpawnObject>> objects;
+    std::vector<SpawnObject*> spawnObjects;
+
+    for (float x : spawnXs) {
+        objects.push_back(std::make_unique<SpawnObject>());
+        objects.back()->spawnX = x;
+        spawnObjects.push_back(objects.back().get());
+    }
+
+    state.setItemsPerIteration(spawnObjects.size());
+
+    // What `PlayScene::resetLevel` does on every attempt.
+    while (state.keepRunning()) {
+        std::vector<SpawnObject*> spawnQueue = spawnObjects;
+        std::stable_sort(spawnQueue.begin(), spawnQueue.end(),
+                         [](SpawnObject* lhs, SpawnObject* rhs) { return lhs->spawnX < rhs->spawnX; });
+        bench::doNotOptimize(spawnQueue.data());
+    }
+}
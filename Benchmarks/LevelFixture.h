@@ -0,0 +1,129 @@
+#pragma once
+
+#include "Benchmark.h"
+
+#include "Objects/CollisionSection.h"
+#include "Objects/ObjectTraits.h"
+#include "Utils/LevelFormat.inl.h"
+#include "Utils/LevelTokenizer.inl.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+/**
+ * Collision data for the sample level, laid out the way `PlayScene` keeps it.
+ *
+ * Sprite frames aren't available without the engine, so every object gets the 30x30 hitbox most
+ * blocks have, adjusted by the size override, scale mod and rotation from `ObjectTraits`. That keeps
+ * the section density and the hazard/solid mix of the real level.
+ */
+namespace bench {
+    constexpr float DEFAULT_OBJECT_SIZE = 30.0f;
+
+    inline CollisionRect objectRect(const ObjectDescriptor& desc, const ObjectTraits& traits) {
+        float size   = traits.sizeOverride.value_or(DEFAULT_OBJECT_SIZE);
+        float width  = size * traits.scaleModX;
+        float height = size * traits.scaleModY;
+
+        if (std::fabs(desc.rotation) == 90 || std::fabs(desc.rotation) == 270) {
+            std::swap(width, height);
+        }
+
+        return {desc.x - width / 2, desc.y - height / 2, desc.x + width / 2, desc.y + height / 2};
+    }
+
+    struct FixtureObject {
+        CollisionRect rect;
+        GameObjectType type;
+        uint8_t flags;
+    };
+
+    struct LevelFixture {
+        std::vector<FixtureObject> objects;
+        std::vector<CollisionSection> sections; ///< `objects` bucketed into 100 unit X sections.
+        std::vector<float> spawnXs;             ///< X of every trigger, in level order (`PlayScene::m_spawnObjects`).
+
+        bool empty() const { return sections.empty(); }
+
+        void add(const FixtureObject& object) {
+            size_t section = static_cast<size_t>(std::max(level_format::section_for_x((object.rect.minX + object.rect.maxX) / 2), 0));
+
+            if (sections.size() <= section) {
+                sections.resize(section + 1);
+            }
+
+            sections[section].add(object.rect, object.type, object.flags);
+            objects.push_back(object);
+        }
+
+        /**
+         * Player rect for substep `step` of a run through the level: ~2.6 units to the right per
+         * substep (4 substeps per 60 Hz frame) while bouncing between the ground and a few blocks up.
+         */
+        CollisionRect playerRect(size_t step) const {
+            float x = std::fmod(step * 2.6f, sections.size() * level_format::SECTION_WIDTH);
+            float y = 105 + std::fabs(std::sin(step * 0.02f)) * 90;
+
+            return {x - 15, y - 15, x + 15, y + 15};
+        }
+    };
+
+    /**
+     * The sample level (`tombstone/level.txt`) as it is.
+     */
+    inline const LevelFixture& levelFixture() {
+        static const LevelFixture fixture = [] {
+            LevelFixture fixture;
+            std::string level = readContentFile("tombstone/level.txt");
+
+            level_tokenizer::for_each_object(level_tokenizer::split_header(level).second, [&](const ObjectDescriptor& desc) {
+                ObjectTraits traits = objectTraitsForKey(desc.objectKey, {});
+
+                if (traits.shouldSpawn) {
+                    fixture.spawnXs.push_back(desc.x);
+                    return;
+                }
+
+                uint8_t flags = (traits.disabled ? CollisionSection::FlagDisabled : 0) |
+                                (traits.type == GameObjectType::Hazard ? CollisionSection::FlagHazard : 0);
+                fixture.add({objectRect(desc, traits), traits.type, flags});
+            });
+
+            return fixture;
+        }();
+
+        return fixture;
+    }
+
+    /**
+     * The sample level with every tenth object repeated upwards in 30 unit steps up to the ceiling
+     * (Y 1590), i.e. towers of blocks and decoration all over the level.
+     */
+    inline const LevelFixture& stackedLevelFixture() {
+        static const LevelFixture fixture = [] {
+            const LevelFixture& level = levelFixture();
+            LevelFixture fixture;
+
+            for (size_t i = 0; i < level.objects.size(); i++) {
+                FixtureObject object = level.objects[i];
+                fixture.add(object);
+
+                if (i % 10 != 0) {
+                    continue;
+                }
+
+                while (object.rect.maxY + 30 <= 1590) {
+                    object.rect.minY += 30;
+                    object.rect.maxY += 30;
+                    fixture.add(object);
+                }
+            }
+
+            return fixture;
+        }();
+
+        return fixture;
+    }
+}
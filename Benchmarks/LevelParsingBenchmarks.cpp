@@ -0,0 +1,147 @@
+#include "Benchmark.h"
+
+#include "Utils/LevelFormat.inl.h"
+#include "Utils/LevelTokenizer.inl.h"
+#include "Utils/SplitString.inl.h"
+
+#include <string>
+
+namespace {
+    const std::string& levelData() {
+        static const std::string data = bench::readContentFile("tombstone/level.txt");
+        return data;
+    }
+
+    /**
+     * The object parser as it was before `level_tokenizer`: one `std::vector<std::string>`
+     * per object and `std::stoi` on every token. Kept here as the baseline to compare against.
+     */
+    ObjectDescriptor legacyParseObject(std::string_view str) {
+        auto arr = split_string::split(str, ",");
+
+        ObjectDescriptor desc;
+        int propertyId = 0;
+
+        for (const std::string& token : arr) {
+            if (propertyId == 0) {
+                if (token.empty() || token == "\n") {
+                    break;
+                }
+                propertyId = std::stoi(token);
+                continue;
+            }
+
+            switch (propertyId) {
+                case 1:
+                    desc.objectKey = std::stoi(token);
+                    break;
+                case 2:
+                    desc.x = static_cast<float>(std::stoi(token));
+                    break;
+                case 3:
+                    desc.y = static_cast<float>(std::stoi(token)) + 90;
+                    break;
+                case 4:
+                    desc.flipX = (bool)std::stoi(token);
+                    break;
+                case 5:
+                    desc.flipY = (bool)std::stoi(token);
+                    break;
+                case 6:
+                    desc.rotation = static_cast<float>(std::stoi(token));
+                    break;
+                case 7:
+                    desc.tint.r = std::stoi(token);
+                    break;
+                case 8:
+                    desc.tint.g = std::stoi(token);
+                    break;
+                case 9:
+                    desc.tint.b = std::stoi(token);
+                    break;
+                case 10:
+                    desc.tintDuration = std::stof(token);
+                    break;
+                default:
+                    break;
+            }
+
+            propertyId = 0;
+        }
+
+        return desc;
+    }
+
+    uint64_t countObjects(std::string_view level) {
+        uint64_t count = 0;
+        level_tokenizer::for_each_object(level_tokenizer::split_header(level).second,
+                                         [&count](const ObjectDescriptor&) { ++count; });
+        return count;
+    }
+}
+
+TOMBSTONE_BENCHMARK(LevelParse_SplitString) {
+    const std::string& level = levelData();
+
+    if (level.empty()) {
+        return state.skip("tombstone/level.txt not found");
+    }
+
+    state.setItemsPerIteration(countObjects(level));
+
+    while (state.keepRunning()) {
+        std::string setup = level;
+        auto [headerSetup, dataSetup] = split_string::split_to_pair(setup, ";");
+
+        split_string::split_streamed(dataSetup, ";", [](std::string_view object) {
+            if (object.empty() || object == "\n") {
+                return;
+            }
+
+            ObjectDescriptor desc = legacyParseObject(object);
+            bench::doNotOptimize(desc);
+        });
+    }
+}
+
+TOMBSTONE_BENCHMARK(LevelParse_Tokenizer) {
+    const std::string& level = levelData();
+
+    if (level.empty()) {
+        return state.skip("tombstone/level.txt not found");
+    }
+
+    state.setItemsPerIteration(countObjects(level));
+
+    while (state.keepRunning()) {
+        auto [headerSetup, dataSetup] = level_tokenizer::split_header(level);
+
+        level_tokenizer::for_each_object(dataSetup, [](const ObjectDescriptor& desc) {
+            bench::doNotOptimize(desc);
+        });
+    }
+}
+
+TOMBSTONE_BENCHMARK(LevelParse_BinaryRecords) {
+    const std::string& level = levelData();
+
+    if (level.empty()) {
+        return state.skip("tombstone/level.txt not found");
+    }
+
+    const std::string binary = level_format::compile(level);
+    level_format::View view;
+
+    if (!view.init(binary)) {
+        return state.skip("level_format::compile produced an invalid level");
+    }
+
+    state.setItemsPerIteration(view.getObjects().size());
+
+    while (state.keepRunning()) {
+        for (const level_format::ObjectRecord& record : view.getObjects()) {
+            ObjectDescriptor desc = level_format::to_descriptor(record);
+            bench::doNotOptimize(desc);
+        }
+    }
+}
@@ -0,0 +1,154 @@
+#include "Benchmark.h"
+#include "LevelFixture.h"
+
+#include "Objects/SpatialGrid.h"
+#include "Utils/RectOverlap.inl.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace {
+    constexpr size_t QUERIES_PER_ITERATION = 256;
+
+    /**
+     * Every hit of one pass over the query set, found by testing the player against every object.
+     * What both indexes have to match exactly.
+     */
+    uint64_t bruteForceHits(const bench::LevelFixture& fixture, size_t queryCount) {
+        uint64_t hits = 0;
+
+        for (size_t step = 0; step < queryCount; step++) {
+            CollisionRect player = fixture.playerRect(step);
+
+            for (const bench::FixtureObject& object : fixture.objects) {
+                hits += object.rect.intersects(player);
+            }
+        }
+
+        return hits;
+    }
+
+    /**
+     * Runs one player query per item, the way `PlayScene::checkCollisions` does once per substep.
+     * `query(player)` returns the number of hits. Those are summed over one pass of the query set
+     * before timing and compared against `bruteForceHits`, the label shows the result.
+     */
+    template <typename Query>
+    void runQueries(bench::State& state, const bench::LevelFixture& fixture, Query&& query) {
+        if (fixture.empty()) {
+            return state.skip("tombstone/level.txt not found");
+        }
+
+        const size_t queryCount = fixture.sections.size() * 40;
+        uint64_t hits           = 0;
+
+        for (size_t step = 0; step < queryCount; step++) {
+            hits += query(fixture.playerRect(step));
+        }
+
+        uint64_t expected = bruteForceHits(fixture, queryCount);
+
+        state.setItemsPerIteration(QUERIES_PER_ITERATION);
+
+        size_t firstStep = 0;
+
+        while (state.keepRunning()) {
+            for (size_t step = firstStep; step < firstStep + QUERIES_PER_ITERATION; step++) {
+                bench::doNotOptimize(query(fixture.playerRect(step)));
+            }
+
+            firstStep = (firstStep + QUERIES_PER_ITERATION) % queryCount;
+        }
+
+        char label[96];
+
+        if (hits == expected) {
+            std::snprintf(label, sizeof(label), "%llu hits over %zu queries, matches brute force",
+                          static_cast<unsigned long long>(hits), queryCount);
+        } else {
+            std::snprintf(label, sizeof(label), "MISMATCH: %llu hits over %zu queries, brute force has %llu",
+                          static_cast<unsigned long long>(hits), queryCount, static_cast<unsigned long long>(expected));
+        }
+
+        state.setLabel(label);
+    }
+
+    void runSections(bench::State& state, const bench::LevelFixture& fixture) {
+        std::vector<uint8_t> mask;
+
+        runQueries(state, fixture, [&](const CollisionRect& player) {
+            int section   = level_format::section_for_x((player.minX + player.maxX) / 2);
+            unsigned hits = 0;
+
+            for (int i = section - 1; i <= section + 1; i++) {
+                if (i < 0 || static_cast<size_t>(i) >= fixture.sections.size()) {
+                    continue;
+                }
+
+                const CollisionSection& collision = fixture.sections[i];
+                mask.resize(collision.size());
+                rect_overlap::overlap_mask(collision, 0, player, mask.data());
+
+                for (uint8_t hit : mask) {
+                    hits += hit;
+                }
+            }
+
+            return hits;
+        });
+    }
+
+    void runGrid(bench::State& state, const bench::LevelFixture& fixture, float cellWidth, float cellHeight) {
+        SpatialGrid<uint32_t> grid(cellWidth, cellHeight);
+
+        for (uint32_t i = 0; i < fixture.objects.size(); i++) {
+            const bench::FixtureObject& object = fixture.objects[i];
+            grid.insert(i, object.rect, object.type, object.flags);
+        }
+
+        std::vector<uint8_t> mask;
+
+        runQueries(state, fixture, [&](const CollisionRect& player) {
+            unsigned hits = 0;
+
+            grid.forEachCell(player, [&](SpatialGrid<uint32_t>::Cell& cell) {
+                mask.resize(cell.objects.size());
+                rect_overlap::overlap_mask(cell.objects, 0, player, mask.data());
+
+                for (uint8_t hit : mask) {
+                    hits += hit;
+                }
+            });
+
+            return hits;
+        });
+    }
+}
+
+TOMBSTONE_BENCHMARK(SpatialIndex_Sections_Level) {
+    runSections(state, bench::levelFixture());
+}
+
+TOMBSTONE_BENCHMARK(SpatialIndex_Grid100x100_Level) {
+    runGrid(state, bench::levelFixture(), 100, 100);
+}
+
+TOMBSTONE_BENCHMARK(SpatialIndex_Sections_Stacked) {
+    runSections(state, bench::stackedLevelFixture());
+}
+
+TOMBSTONE_BENCHMARK(SpatialIndex_Grid100x100_Stacked) {
+    runGrid(state, bench::stackedLevelFixture(), 100, 100);
+}
+
+TOMBSTONE_BENCHMARK(SpatialIndex_Grid100x60_Stacked) {
+    runGrid(state, bench::stackedLevelFixture(), 100, 60);
+}
+
+TOMBSTONE_BENCHMARK(SpatialIndex_Grid50x50_Stacked) {
+    runGrid(state, bench::stackedLevelFixture(), 50, 50);
+}
+
+TOMBSTONE_BENCHMARK(SpatialIndex_Grid200x200_Stacked) {
+    runGrid(state, bench::stackedLevelFixture(), 200, 200);
+}
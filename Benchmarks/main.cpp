@@ -0,0 +1,100 @@
+#include "Benchmark.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#ifndef TOMBSTONE_CONTENT_DIR
+#    define TOMBSTONE_CONTENT_DIR "Content"
+#endif
+
+namespace {
+    std::string g_contentDir = TOMBSTONE_CONTENT_DIR;
+}
+
+namespace bench {
+    std::vector<Entry>& registry() {
+        static std::vector<Entry> entries;
+        return entries;
+    }
+
+    Registration::Registration(const char* name, BenchmarkFunc func) {
+        registry().push_back({name, func});
+    }
+
+    std::string readContentFile(std::string_view path) {
+        std::ifstream file(g_contentDir + "/" + std::string(path), std::ios::binary);
+
+        if (!file) {
+            return {};
+        }
+
+        std::ostringstream buffer;
+        buffer << file.rdbuf();
+        return buffer.str();
+    }
+}
+
+static void printUsage(const char* exe) {
+    std::printf("usage: %s [--filter <substring>] [--min-time <seconds>] [--content <dir>] [--list]\n", exe);
+}
+
+int main(int argc, char** argv) {
+    std::string filter;
+    double minTime = 0.5;
+    bool listOnly  = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg = argv[i];
+
+        if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            minTime = std::atof(argv[++i]);
+        } else if (arg == "--content" && i + 1 < argc) {
+            g_contentDir = argv[++i];
+        } else if (arg == "--list") {
+            listOnly = true;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::printf("%-48s %12s %14s %16s\n", "benchmark", "iterations", "ns/iter", "items/s");
+
+    for (const bench::Entry& entry : bench::registry()) {
+        if (!filter.empty() && entry.name.find(filter) == std::string::npos) {
+            continue;
+        }
+
+        if (listOnly) {
+            std::printf("%s\n", entry.name.c_str());
+            continue;
+        }
+
+        bench::State state(minTime);
+        entry.func(state);
+
+        if (!state.getSkipReason().empty()) {
+            std::printf("%-48s skipped: %s\n", entry.name.c_str(), state.getSkipReason().c_str());
+            continue;
+        }
+
+        double iterations = static_cast<double>(state.getIterations());
+        double nsPerIter  = (iterations > 0) ? state.getElapsed() * 1e9 / iterations : 0;
+        double itemsPerSec =
+            (state.getElapsed() > 0) ? iterations * state.getItemsPerIteration() / state.getElapsed() : 0;
+
+        std::printf("%-48s %12.0f %14.1f %16.0f", entry.name.c_str(), iterations, nsPerIter, itemsPerSec);
+
+        if (!state.getLabel().empty()) {
+            std::printf("  %s", state.getLabel().c_str());
+        }
+
+        std::printf("\n");
+    }
+
+    return 0;
+}
@@ -26,10 +26,12 @@
 #include "AppDelegate.h"
 #include "Managers/AssetManager.h"
 #include "Scenes/LoadingLayer.h"
+#include "Utils/Trace.inl.h"
 
 #include <base/Director.h>
 #include <platform/GLView.h>
 #include <platform/GLViewImpl.h>
+#include <platform/FileUtils.h>
 
 #define USE_AUDIO_ENGINE 1
 
@@ -43,7 +45,9 @@ static ax::Size designResolutionSize = ax::Size(480, 320);
 
 AppDelegate::AppDelegate() {}
 
-AppDelegate::~AppDelegate() {}
+AppDelegate::~AppDelegate() {
+    TRACE_FLUSH();
+}
 
 // if you want a different context, modify the value of glContextAttrs
 // it will affect all platforms
@@ -61,6 +65,9 @@ bool AppDelegate::applicationDidFinishLaunching() {
     ax::GLView*   glView       = director->getGLView();
     AssetManager* assetManager = AssetManager::getInstance();
 
+    TRACE_THREAD_NAME("main");
+    TRACE_SET_OUTPUT(FileUtils::getInstance()->getWritablePath() + "trace.json");
+
     if (glView == nullptr) {
 #ifdef AX_PLATFORM_PC
         glView = GLViewImpl::createWithRect(
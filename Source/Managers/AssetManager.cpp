@@ -1,5 +1,6 @@
 #include "AssetManager.h"
 
+#include <2d/ParticleSystemQuad.h>
 #include <2d/Sprite.h>
 #include <2d/SpriteFrameCache.h>
 #include <renderer/TextureCache.h>
@@ -42,6 +43,38 @@ ax::Texture2D* AssetManager::addTextureToCache(std::string_view filePath, bool f
     );
 }
 
+ax::ParticleSystemQuad* AssetManager::createParticle(std::string_view plistPath) {
+    ax::ValueMap* dictionary = getParticleTemplate(plistPath);
+
+    if (!dictionary) {
+        return nullptr;
+    }
+
+    return ax::ParticleSystemQuad::create(*dictionary);
+}
+
+void AssetManager::preloadParticle(std::string_view plistPath) {
+    // Setting a system up once puts its texture into the texture cache, embedded or not.
+    createParticle(plistPath);
+}
+
+ax::ValueMap* AssetManager::getParticleTemplate(std::string_view plistPath) {
+    auto it = m_particleTemplates.find(plistPath);
+
+    if (it == m_particleTemplates.end()) {
+        ax::FileUtils* fileUtils = ax::FileUtils::getInstance();
+        ax::ValueMap dictionary  = fileUtils->getValueMapFromFile(fileUtils->fullPathForFilename(plistPath));
+
+        if (dictionary.empty()) {
+            return nullptr;
+        }
+
+        it = m_particleTemplates.emplace(plistPath, std::move(dictionary)).first;
+    }
+
+    return &it->second;
+}
+
 std::string AssetManager::getForwardedFileName(std::string path) {
     std::string suffixed = appendTextureQualitySuffix(path);
 
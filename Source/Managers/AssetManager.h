@@ -1,9 +1,15 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
+#include <string>
 #include <string_view>
+#include <unordered_map>
+
+#include <base/Value.h>
 
 namespace ax {
+    class ParticleSystemQuad;
     class Sprite;
     class Texture2D;
 };
@@ -29,6 +35,17 @@ public:
     void addSpriteFramesWithFile(std::string_view filePath, bool forwardPath = true);
     ax::Texture2D* addTextureToCache(std::string_view filePath, bool forwardPath = true);
 
+    /**
+     * Same as `ax::ParticleSystemQuad::create(plistPath)`, but the plist is only read and parsed the
+     * first time, later systems are set up from the cached dictionary. Autoreleased.
+     */
+    ax::ParticleSystemQuad* createParticle(std::string_view plistPath);
+
+    /**
+     * Parses `plistPath` and loads its texture now, so the first `createParticle` doesn't.
+     */
+    void preloadParticle(std::string_view plistPath);
+
     std::string getForwardedFileName(std::string filePath);
     bool doesFileExist(std::string_view path);
 private:
@@ -42,6 +59,18 @@ private:
 
     std::string& appendTextureQualitySuffix(std::string& str) const;
 
+    /**
+     * Never modified once loaded.
+     */
+    ax::ValueMap* getParticleTemplate(std::string_view plistPath);
+
 private:
+    struct PathHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view str) const { return std::hash<std::string_view>()(str); }
+    };
+
     TextureQuality m_textureQuality = TextureQuality::Medium;
+
+    std::unordered_map<std::string, ax::ValueMap, PathHash, std::equal_to<>> m_particleTemplates;
 };
@@ -1,9 +1,17 @@
 #pragma once
 
+#include <string>
+#include <string_view>
+
 namespace ax {
     class Color3B;
 }
 
+enum class CollisionMode {
+    Substeps, ///< Physics ticks at 240 Hz (four per 60 Hz frame), each followed by a regular overlap test.
+    Swept,    ///< Physics ticks at 60 Hz, tested against everything the player swept through.
+};
+
 class GameManager {
 public:
     static GameManager* singleton() {
@@ -19,7 +27,69 @@ public:
     int getPlayerColor2() const {
         return m_playerColor2;
     }
+
+    /**
+     * When enabled, PlayScene only builds the objects of the sections around the camera
+     * and drops them again once they scroll out.
+     */
+    bool getLazyObjects() const {
+        return m_lazyObjects;
+    }
+    void setLazyObjects(bool lazy) {
+        m_lazyObjects = lazy;
+    }
+
+    /**
+     * Cell size of PlayScene's 2D object grid. Only read when a level starts.
+     */
+    float getGridCellWidth() const {
+        return m_gridCellWidth;
+    }
+    float getGridCellHeight() const {
+        return m_gridCellHeight;
+    }
+    void setGridCellSize(float width, float height) {
+        m_gridCellWidth  = width;
+        m_gridCellHeight = height;
+    }
+
+    /**
+     * How PlayScene steps the player and detects collisions. Only read when a level starts.
+     */
+    CollisionMode getCollisionMode() const {
+        return m_collisionMode;
+    }
+    void setCollisionMode(CollisionMode mode) {
+        m_collisionMode = mode;
+    }
+
+    /**
+     * `.tbrp` file PlayScene plays back instead of taking input, empty to play normally. Replays are
+     * recorded with the same collision mode they're played back in. Only read when a level starts.
+     */
+    const std::string& getReplayPath() const {
+        return m_replayPath;
+    }
+    void setReplayPath(std::string_view path) {
+        m_replayPath = path;
+    }
+
+    /**
+     * Samples the jump key on `InputThread` where the platform allows it. Only read when a level starts.
+     */
+    bool getInputThread() const {
+        return m_inputThread;
+    }
+    void setInputThread(bool enabled) {
+        m_inputThread = enabled;
+    }
 private:
     int m_playerColor = 0;
     int m_playerColor2 = 0;
+    bool m_lazyObjects = true;
+    float m_gridCellWidth = 100;
+    float m_gridCellHeight = 100;
+    CollisionMode m_collisionMode = CollisionMode::Substeps;
+    std::string m_replayPath;
+    bool m_inputThread = false;
 };
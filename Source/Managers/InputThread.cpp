@@ -0,0 +1,87 @@
+#include "InputThread.h"
+
+#if defined(_WIN32)
+#    define WIN32_LEAN_AND_MEAN
+#    define NOMINMAX
+#    include <windows.h>
+#    include <timeapi.h>
+
+#    include <base/Director.h>
+#    include <platform/GLViewImpl.h>
+#endif
+
+/**
+ * Whether the jump key is held down right now, readable from any thread.
+ */
+static bool sampleButton(void* nativeWindow) {
+#if defined(_WIN32)
+    if (GetForegroundWindow() != static_cast<HWND>(nativeWindow)) {
+        return false;
+    }
+
+    return (GetAsyncKeyState(VK_UP) & 0x8000) != 0;
+#else
+    return false;
+#endif
+}
+
+InputThread::~InputThread() {
+    stop();
+}
+
+bool InputThread::isSupported() {
+#if defined(_WIN32)
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool InputThread::start() {
+    stop();
+
+    if (!isSupported()) {
+        return false;
+    }
+
+#if defined(_WIN32)
+    m_nativeWindow = static_cast<ax::GLViewImpl*>(ax::Director::getInstance()->getGLView())->getWin32Window();
+#endif
+    m_stopped      = false;
+    m_thread       = std::thread(&InputThread::run, this);
+    return true;
+}
+
+void InputThread::stop() {
+    m_stopped = true;
+
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void InputThread::run() {
+#if defined(_WIN32)
+    // The default timer resolution (15.6 ms) would make sleeping between samples worse than polling
+    // on the main thread.
+    timeBeginPeriod(1);
+#endif
+
+    bool held = sampleButton(m_nativeWindow);
+
+    while (!m_stopped) {
+        bool nowHeld = sampleButton(m_nativeWindow);
+
+        // The ring is only full while the game isn't draining it (paused), the edge is retried on the
+        // next sample so presses and releases stay paired.
+        if (nowHeld != held && m_edges.push({std::chrono::steady_clock::now(), PlayerButton::Unk, nowHeld})) {
+            held = nowHeld;
+        }
+
+        std::this_thread::sleep_for(POLL_INTERVAL);
+    }
+
+#if defined(_WIN32)
+    timeEndPeriod(1);
+#endif
+}
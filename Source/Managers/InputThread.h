@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "Objects/PlayerObject.h"
+#include "Utils/SpscRing.inl.h"
+
+/**
+ * Samples the jump key on its own thread and hands the edges to the game through a lock-free ring,
+ * stamped with the time they were seen. A slow frame then no longer delays when input gets sampled,
+ * only when it gets applied, and `PlayScene` places it on the right tick anyway.
+ *
+ * GLFW can only be polled from the main thread, so this needs a key state that can be read from
+ * anywhere. That only exists on Windows (`GetAsyncKeyState`), see `isSupported`. Everywhere else
+ * input keeps coming from the event dispatcher.
+ */
+class InputThread {
+public:
+    struct ButtonEdge {
+        std::chrono::steady_clock::time_point time;
+        PlayerButton button;
+        bool press;
+    };
+
+    static constexpr auto POLL_INTERVAL = std::chrono::microseconds(500);
+
+    InputThread() = default;
+    ~InputThread();
+
+    InputThread(const InputThread&)            = delete;
+    InputThread& operator=(const InputThread&) = delete;
+
+    static bool isSupported();
+
+    /**
+     * Starts sampling while the game's window has focus. Returns false if the platform isn't supported.
+     */
+    bool start();
+
+    /**
+     * Stops the thread and waits for it.
+     */
+    void stop();
+
+    bool isRunning() const { return m_thread.joinable(); }
+
+    /**
+     * Takes the oldest edge that hasn't been taken yet. Main thread only.
+     */
+    bool popEdge(ButtonEdge& edge) { return m_edges.pop(edge); }
+
+private:
+    void run();
+
+private:
+    std::thread m_thread;
+    std::atomic<bool> m_stopped {true};
+    void* m_nativeWindow = nullptr;
+
+    SpscRing<ButtonEdge, 256> m_edges;
+};
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "GameObjectType.h"
+
+/**
+ * Axis-aligned hitbox in game space, same edges as `GameObject::getObjectRect`.
+ */
+struct CollisionRect {
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+
+    /**
+     * Same test as `ax::Rect::intersectsRect`, touching edges count as a hit.
+     */
+    bool intersects(const CollisionRect& other) const {
+        return !(maxX < other.minX || other.maxX < minX || maxY < other.minY || other.maxY < minY);
+    }
+
+    bool operator==(const CollisionRect&) const = default;
+};
+
+/**
+ * Struct-of-arrays copy of what `PlayScene::checkCollisions` needs from the objects of one grid cell,
+ * so the sweep runs over a few flat arrays instead of chasing `GameObject` pointers.
+ *
+ * Every `SpatialGrid::Cell` owns one. Index `i` here is the object at index `i` of that cell's
+ * `handles`; both are appended and erased together. The hitbox is taken from `GameObject::getObjectRect` when the object
+ * is added, which already folds in the start position, hitbox size, scale mod and the rotated flag.
+ * None of those change once an object has been placed.
+ */
+class CollisionSection {
+public:
+    enum Flags : uint8_t {
+        FlagDisabled  = 1 << 0,
+        FlagActivated = 1 << 1, ///< Only ever a hint, see `PlayScene::checkCollisions`.
+        FlagHazard    = 1 << 2, ///< Tested through `HazardIndex` instead.
+    };
+
+    void add(const CollisionRect& rect, GameObjectType type, uint8_t flags) {
+        m_minX.push_back(rect.minX);
+        m_minY.push_back(rect.minY);
+        m_maxX.push_back(rect.maxX);
+        m_maxY.push_back(rect.maxY);
+        m_types.push_back(type);
+        m_flags.push_back(flags);
+    }
+
+    void erase(size_t idx) {
+        m_minX.erase(m_minX.begin() + idx);
+        m_minY.erase(m_minY.begin() + idx);
+        m_maxX.erase(m_maxX.begin() + idx);
+        m_maxY.erase(m_maxY.begin() + idx);
+        m_types.erase(m_types.begin() + idx);
+        m_flags.erase(m_flags.begin() + idx);
+    }
+
+    void clear() {
+        m_minX.clear();
+        m_minY.clear();
+        m_maxX.clear();
+        m_maxY.clear();
+        m_types.clear();
+        m_flags.clear();
+    }
+
+    size_t size() const { return m_types.size(); }
+    bool empty() const { return m_types.empty(); }
+
+    CollisionRect getRect(size_t idx) const {
+        return {m_minX[idx], m_minY[idx], m_maxX[idx], m_maxY[idx]};
+    }
+
+    GameObjectType getType(size_t idx) const { return m_types[idx]; }
+    uint8_t getFlags(size_t idx) const { return m_flags[idx]; }
+
+    void setActivated(size_t idx, bool activated) {
+        if (activated) {
+            m_flags[idx] |= FlagActivated;
+        } else {
+            m_flags[idx] &= ~FlagActivated;
+        }
+    }
+
+    void clearActivated() {
+        for (uint8_t& flags : m_flags) {
+            flags &= ~FlagActivated;
+        }
+    }
+
+    const float* getMinX() const { return m_minX.data(); }
+    const float* getMinY() const { return m_minY.data(); }
+    const float* getMaxX() const { return m_maxX.data(); }
+    const float* getMaxY() const { return m_maxY.data(); }
+    const GameObjectType* getTypes() const { return m_types.data(); }
+    const uint8_t* getFlags() const { return m_flags.data(); }
+
+private:
+    std::vector<float> m_minX;
+    std::vector<float> m_minY;
+    std::vector<float> m_maxX;
+    std::vector<float> m_maxY;
+    std::vector<GameObjectType> m_types;
+    std::vector<uint8_t> m_flags;
+};
@@ -1,5 +1,7 @@
 #include "GameObject.h"
-#include "Utils/SplitString.inl.h"
+#include "ObjectDictionary.h"
+#include "Utils/LevelTokenizer.inl.h"
+#include "Utils/Trace.inl.h"
 #include "Scenes/PlayLayer.h"
 #include "State.h"
 
@@ -9,22 +11,6 @@
 #include <platform/FileUtils.h>
 #include <base/Utils.h>
 
-#include <nlohmann/json.hpp>
-
-enum class ObjectPropertyID {
-    Invalid      = 0,
-    ObjectID     = 1,
-    PosX         = 2,
-    PosY         = 3,
-    FlipX        = 4,
-    FlipY        = 5,
-    Rotation     = 6,
-    TintR        = 7,
-    TintG        = 8,
-    TintB        = 9,
-    TintDuration = 10
-};
-
 class GameObjectDictionary {
 private:
     static GameObjectDictionary& getInstance() {
@@ -38,6 +24,11 @@ public:
     static bool isKeyDefined(int id) {
         return getInstance().m_keyToFrameMap.contains(id);
     }
+    static const std::string* findFrame(int id) {
+        auto& map = getInstance().m_keyToFrameMap;
+        auto it   = map.find(id);
+        return (it != map.end()) ? &it->second : nullptr;
+    }
 
     bool initFromFile(std::string_view filePath);
 private:
@@ -54,107 +45,28 @@ GameObjectDictionary::GameObjectDictionary() {
 }
 
 bool GameObjectDictionary::initFromFile(std::string_view filePath) {
-    nlohmann::basic_json<> data;
-
-    {
-        std::string buffer;
-        ax::FileUtils::getInstance()->getContents(filePath, &buffer);
-        data = nlohmann::json::parse(buffer);
-    }
-
-    if (!data.is_array()) {
-        return false;
-    }
+    std::string buffer;
+    ax::FileUtils::getInstance()->getContents(filePath, &buffer);
 
-    for (nlohmann::basic_json<>& entry : data) {
-        if (!entry.is_object()) {
-            continue;
-        }
-
-        auto key = entry.value<int>("idx", 0);
-        auto texture = entry.value<std::string>("texture", "");
-
-        m_keyToFrameMap[key] = texture;
-    }
-
-    return true;
+    return parseObjectDictionary(buffer, m_keyToFrameMap);
 }
 
 
 
-GameObject::~GameObject() {
-    if (m_glowSprite) {
-        m_glowSprite->removeFromParent();
-        m_glowSprite->release();
-    }
-}
-
 GameObject* GameObject::createFromString(std::string_view str) {
-    auto arr = split_string::split(str, ",");
-
-    ObjectPropertyID propertyId = ObjectPropertyID::Invalid;
-    int objectId                = -1;
-    float xPos                  = 0;
-    float yPos                  = 0;
-    float rot                   = 0;
-    bool flipX                  = false;
-    bool flipY                  = false;
-    ax::Color3B tint            = {};
-    float tintDuration          = 0;
-
-    for (const std::string& str : arr) {
-        if (propertyId == ObjectPropertyID::Invalid) {
-            if (str.empty() || str == "\n") {
-                break;
-            }
-            propertyId = (ObjectPropertyID)std::stoi(str);
-            continue;
-        }
+    return createFromDescriptor(level_tokenizer::parse_object(str));
+}
 
-        switch (propertyId) {
-            case ObjectPropertyID::ObjectID:
-                objectId = std::stoi(str);
-                break;
-            case ObjectPropertyID::PosX:
-                xPos = static_cast<float>(std::stoi(str));
-                break;
-            case ObjectPropertyID::PosY:
-                yPos = static_cast<float>(std::stoi(str)) + 90;
-                break;
-            case ObjectPropertyID::Rotation:
-                rot = static_cast<float>(std::stoi(str));
-                break;
-            case ObjectPropertyID::FlipX:
-                flipX = (bool)std::stoi(str);
-                break;
-            case ObjectPropertyID::FlipY:
-                flipY = (bool)std::stoi(str);
-                break;
-            case ObjectPropertyID::TintR:
-                tint.r = std::stoi(str);
-                break;
-            case ObjectPropertyID::TintG:
-                tint.g = std::stoi(str);
-                break;
-            case ObjectPropertyID::TintB:
-                tint.b = std::stoi(str);
-                break;
-            case ObjectPropertyID::TintDuration:
-                tintDuration = std::stof(str);
-                break;
-            default:
-                break;
-        }
+GameObject* GameObject::createFromDescriptor(const ObjectDescriptor& desc) {
+    const int objectId = desc.objectKey;
 
-        propertyId = ObjectPropertyID::Invalid;
-    }
+    const std::string* frame = GameObjectDictionary::findFrame(objectId);
 
-    if (!GameObjectDictionary::isKeyDefined(objectId)) {
+    if (!frame) {
         return nullptr;
     }
 
-    auto obj = ax::utils::createInstance<GameObject>(
-        &GameObject::init, GameObjectDictionary::keyToFrame(objectId));
+    auto obj = ax::utils::createInstance<GameObject>(&GameObject::init, *frame);
 
     obj->setObjectKey(objectId);
 
@@ -163,23 +75,47 @@ GameObject* GameObject::createFromString(std::string_view str) {
     }
 
     obj->addGlow();
+    obj->applyDescriptor(desc);
+    obj->customSetup();
+
+    return obj;
+}
 
-    obj->setPosition({xPos, yPos});
-    obj->setStartPosition(obj->getPosition());
+void GameObject::reuseFromDescriptor(const ObjectDescriptor& desc) {
+    resetForReuse();
+    applyDescriptor(desc);
+}
 
-    obj->setRotation(rot);
+void GameObject::applyDescriptor(const ObjectDescriptor& desc) {
+    setPosition({desc.x, desc.y});
+    setStartPosition(getPosition());
 
-    obj->setFlippedX(flipX);
-    obj->setFlippedY(flipY);
+    setRotation(desc.rotation);
 
-    obj->customSetup();
+    setFlippedX(desc.flipX);
+    setFlippedY(desc.flipY);
 
-    if (obj->getFrame() == "edit_eTintBGBtn_001.png" || obj->getFrame() == "edit_eTintGBtn_001.png") {
-        obj->setTintColor(tint);
-        obj->setTintDuration(tintDuration);
+    if (m_frame == "edit_eTintBGBtn_001.png" || m_frame == "edit_eTintGBtn_001.png") {
+        setTintColor({desc.tint.r, desc.tint.g, desc.tint.b});
+        setTintDuration(desc.tintDuration);
     }
+}
 
-    return obj;
+void GameObject::loadObjectDictionary() {
+    GameObjectDictionary::isKeyDefined(0);
+}
+
+bool GameObject::isKeyDefined(int objectKey) {
+    return GameObjectDictionary::isKeyDefined(objectKey);
+}
+
+const std::string* GameObject::frameForKey(int objectKey) {
+    return GameObjectDictionary::findFrame(objectKey);
+}
+
+ObjectTraits GameObject::traitsForKey(int objectKey) {
+    const std::string* frame = GameObjectDictionary::findFrame(objectKey);
+    return objectTraitsForKey(objectKey, frame ? std::string_view(*frame) : std::string_view());
 }
 
 GameObject* GameObject::create(std::string_view texture) {
@@ -189,10 +125,6 @@ GameObject* GameObject::create(std::string_view texture) {
 void GameObject::setRotation(float rot) {
     Sprite::setRotation(rot);
     m_rotated = (std::fabs(rot) == 90 || std::fabs(rot) == 270);
-
-    if (m_glowSprite) {
-        m_glowSprite->setRotation(rot);
-    }
 }
 
 void GameObject::activateObject() {
@@ -202,6 +134,9 @@ void GameObject::activateObject() {
         return;
     }
 
+    // Below the early out, that one runs for every object on screen every frame.
+    TRACE_SCOPE("GameObject::activateObject");
+
     m_active = true;
 
     if (m_isInvisible) {
@@ -215,19 +150,22 @@ void GameObject::activateObject() {
     }
 
     if (m_objectParent) {
-        m_objectParent->addChild(this, m_objectZ);
+        m_objectParent->addObject(this);
     }
 
-    if (m_hasGlow) {
-        ax::SpriteBatchNode* batchNode = State::getInstance()->getPlayLayer()->getBatchNodeAdd();
-        batchNode->addChild(m_glowSprite);
+    if (m_glow) {
+        State::getInstance()->getPlayLayer()->getGlowBatchNode()->addObject(this);
     }
 }
 
 void GameObject::deactivateObject() {
-    if (!m_shouldHide) {
-        m_shouldHide = true;
-        return;
+    // `PlayScene::updateVisibility` only calls this for objects that left the screen, it no longer
+    // needs the extra frame `m_shouldHide` used to give objects that were activated again.
+    m_shouldHide = true;
+
+    // Before the early out, whoever queued the object's enter effect didn't necessarily activate it.
+    if (m_enterEffectSlot >= 0) {
+        State::getInstance()->getPlayLayer()->removeEnterEffect(this);
     }
 
     if (!m_active) {
@@ -240,16 +178,45 @@ void GameObject::deactivateObject() {
 
     //TODO:PlayLayer::unregisterStateObject
 
-    // removeFromParentAndCleanup crashes?
-    if (this->getParent())
-        if (this->getParent()->getChildren().contains(this))
-            this->getParent()->removeChild(this, false);
+    if (m_objectParent) {
+        m_objectParent->removeObject(this);
+    }
 
-    if (m_hasGlow && m_glowSprite->getParent()) {
-        m_glowSprite->removeFromParentAndCleanup(false);
+    if (m_glowIndex >= 0) {
+        State::getInstance()->getPlayLayer()->getGlowBatchNode()->removeObject(this);
     }
 }
 
+void GameObject::updateQuad() {
+    if (m_objectParent) {
+        m_objectParent->updateObject(this);
+    }
+
+    if (m_glowIndex >= 0) {
+        State::getInstance()->getPlayLayer()->getGlowBatchNode()->updateObject(this);
+    }
+}
+
+void GameObject::releaseObject() {
+    m_shouldHide = true;
+    deactivateObject();
+
+    if (m_particleSystem) {
+        State::getInstance()->getPlayLayer()->unclaimParticle(m_particleId, m_particleSystem);
+        m_particleSystem = nullptr;
+    }
+}
+
+void GameObject::resetForReuse() {
+    m_hasBeenActivated = false;
+    m_enterEffect      = 0;
+    m_enterAngle       = 0;
+    m_startRotation    = 0;
+
+    setScale(m_startScale.x, m_startScale.y);
+    setOpacity(255);
+}
+
 bool GameObject::getShouldSpawn() {
     return m_shouldSpawn;
 }
@@ -348,10 +315,11 @@ ax::ParticleSystemQuad* GameObject::createAndAddParticle(
     int type, const char* plist, int unk, ax::ParticleSystem::PositionType posType)
 {
     PlayScene* playLayer = State::getInstance()->getPlayLayer();
-    ax::ParticleSystemQuad* ret = playLayer->createParticle(type, plist, unk, posType);
-    m_particleKey   = playLayer->getParticleKey(type, plist, unk, posType);
+    m_particleId    = playLayer->internParticle(type, plist, unk, posType);
     m_addedParticle = true;
 
+    ax::ParticleSystemQuad* ret = playLayer->createParticle(m_particleId);
+
     return ret;
 }
 
@@ -361,14 +329,18 @@ void GameObject::setVisible(bool visible)
 
     if (m_addedParticle) {
         if (isVisible() != visible) {
-            if (m_particleSystem) {
-                m_particleSystem->setVisible(visible);
+            if (m_particleSystem && visible) {
+                m_particleSystem->setVisible(true);
                 m_particleSystem->resetSystem();
-            } else {
+            } else if (m_particleSystem) {
+                // Hiding doesn't stop a batched system from being drawn, handing it back stops it.
+                State::getInstance()->getPlayLayer()->unclaimParticle(m_particleId, m_particleSystem);
+                m_particleSystem = nullptr;
+            } else if (visible) {
                 auto state = State::getInstance();
                 auto pl    = state->getPlayLayer();
 
-                m_particleSystem = pl->claimParticle(m_particleKey);
+                m_particleSystem = pl->claimParticle(m_particleId, isFlippedX() || isFlippedY() || getRotation() != 0);
                 this->setPosition(getPosition());
 
                 if (m_particleSystem) {
@@ -377,22 +349,22 @@ void GameObject::setVisible(bool visible)
 
                     m_particleSystem->setRotation(getRotation());
 
-                    m_particleSystem->setVisible(visible);
+                    m_particleSystem->setVisible(true);
                     m_particleSystem->resetSystem();
                 }
             }
         } else {
             auto state      = State::getInstance();
             auto pl         = state->getPlayLayer();
-            pl->unclaimParticle(m_particleKey.c_str(), m_particleSystem);
+            pl->unclaimParticle(m_particleId, m_particleSystem);
             m_particleSystem = nullptr;
         }
     }
 
     Sprite::setVisible(visible);
 
-    if (m_glowSprite) {
-        m_glowSprite->setVisible(visible);
+    if (m_glowIndex >= 0) {
+        State::getInstance()->getPlayLayer()->getGlowBatchNode()->updateObject(this);
     }
 }
 
@@ -400,16 +372,11 @@ void GameObject::setPosition(const ax::Vec2& pos) {
     Sprite::setPosition(pos);
     
     if (PlayScene* playLayer = State::getInstance()->getPlayLayer(); playLayer && m_particleSystem) {
-        ax::Layer* gameLayer = playLayer->getGamelayer();
-        ax::Point positionInGameLayerSpace = gameLayer->convertToNodeSpace(
-            this->convertToWorldSpace(this->getTextureRect().size / 2)
-        );
-        
-        m_particleSystem->setPosition(positionInGameLayerSpace);
-    }
+        // Objects aren't in the scene graph, their batch node sits at the origin of the game layer.
+        ax::Vec3 positionInGameLayerSpace(getTextureRect().size.width / 2, getTextureRect().size.height / 2, 0);
+        getNodeToParentTransform().transformPoint(&positionInGameLayerSpace);
 
-    if (m_glowSprite) {
-        m_glowSprite->setPosition(pos);
+        m_particleSystem->setPosition({positionInGameLayerSpace.x, positionInGameLayerSpace.y});
     }
 }
 
@@ -445,14 +412,7 @@ void GameObject::addGlow() {
         case 81:
         case 82:
             m_hasGlow = true;
-            m_glowSprite = Sprite::createWithSpriteFrameName(
-                m_frame.substr(0, m_frame.find("_001.png")).append("_glow_001.png"));
-            
-            if (m_glowSprite) {
-                m_glowSprite->retain();
-                m_glowSprite->setPosition(getPosition());
-                m_glowSprite->setOpacity(255);
-            }
+            m_glow    = GlowBatchNode::glowForFrame(m_frame.substr(0, m_frame.find("_001.png")).append("_glow_001.png"));
             break;
         default:
             break;
@@ -463,61 +423,9 @@ void GameObject::resetObject() {
     m_hasBeenActivated = false;
 }
 
-void GameObject::setScale(float scale) {
-    Sprite::setScale(scale);
-
-    if (m_glowSprite) {
-        m_glowSprite->setScale(scale);
-    }
-}
-
-void GameObject::setScale(float x, float y) {
-    Sprite::setScale(x, y);
-
-    if (m_glowSprite) {
-        m_glowSprite->setScale(x, y);
-    }
-}
-
-void GameObject::setScaleX(float scale) {
-    Sprite::setScaleX(scale);
-
-    if (m_glowSprite) {
-        m_glowSprite->setScaleX(scale);
-    }
-}
-
-void GameObject::setScaleY(float scale) {
-    Sprite::setScaleY(scale);
-
-    if (m_glowSprite) {
-        m_glowSprite->setScaleY(scale);
-    }
-}
-
-void GameObject::setFlippedX(bool flipped) {
-    Sprite::setFlippedX(flipped);
-
-    if (m_glowSprite) {
-        m_glowSprite->setFlippedX(flipped);
-    }
-}
-
-void GameObject::setFlippedY(bool flipped) {
-    Sprite::setFlippedY(flipped);
-
-    if (m_glowSprite) {
-        m_glowSprite->setFlippedY(flipped);
-    }
-}
-
 void GameObject::setOpacity(uint8_t opacity) {
     Sprite::setOpacity(opacity);
 
-    if (m_glowSprite) {
-        m_glowSprite->setOpacity(opacity);
-    }
-
     if (!m_particleSystem) {
         return;
     }
@@ -551,182 +459,40 @@ void GameObject::calculateSpawnXPos() {
 }
 
 void GameObject::customSetup() {
-#define CREATE_PARTICLE(plist, tag) createAndAddParticle(static_cast<int>(m_type), plist, tag,\
-ax::ParticleSystem::PositionType::GROUPED)
+    ObjectTraits traits = objectTraitsForKey(m_objectKey, m_frame);
 
-    switch (m_objectKey) {
-        case 5:
-        case 73:
-        case 80:
-            m_type = GameObjectType::UnknownType;
-            m_objectZ = -2;
-            m_disabled = true;
-            break;
-        case 8:
-            m_size = {30, 30};
-            [[fallthrough]];
-        case 39:
-            m_type    = GameObjectType::Hazard;
-            m_scaleMod   = {0.2f, 0.4f};
-            break;
-        case 9:
-        case 61:
-            m_type              = GameObjectType::Hazard;
-            m_scaleMod          = {0.4f, 0.3f};
-            break;
-        case 10:
-            m_type = GameObjectType::NormalGravityPortal;
-            m_objectZ = 10;
-            CREATE_PARTICLE("portalEffect01.plist", 3);
-            break;
-        case 11:
-            m_type  = GameObjectType::InvertGravityPortal;
-            m_objectZ         = 10;
-            CREATE_PARTICLE("portalEffect02.plist", 3);
-            break;
-        case 12:
-            m_type            = GameObjectType::CubePortal;
-            m_objectZ         = 10;
-            CREATE_PARTICLE("portalEffect03.plist", 3);
-            break;
-        case 13:
-            m_type            = GameObjectType::ShipPortal;
-            m_objectZ         = 10;
-            CREATE_PARTICLE("portalEffect04.plist", 3);
-            break;
-        case 15:
-        case 16:
-        case 17:
-            m_type  = GameObjectType::UnknownType;
-            m_objectZ = -1;
-            m_disabled = true;
-            break;
-        case 18:
-        case 19:
-        case 20:
-        case 21:
-            m_blendAdditive = 1;
-            m_usePCol1      = true;
-            m_type          = GameObjectType::UnknownType;
-            m_objectZ       = 0;
-            m_disabled      = true;
-            break;
-        case 35:
-            m_type    = GameObjectType::YellowPad;
-            m_scaleMod          = {1.0, 1.0};
-            CREATE_PARTICLE("bumpEffect.plist", 0);
-            break;
-        case 36:
-            m_type        = GameObjectType::YellowOrb;
-            m_isOrb                 = true;
-            m_useAudioScale         = true;
-            m_scaleMod              = {1.2, 1.2};
-            CREATE_PARTICLE("ringEffect.plist", 3);
-            break;
-        case 37:
-            m_usePCol1 = true;
-            m_type = GameObjectType::UnknownType2;
-            m_useAudioScale = true;
-            m_disabled      = true;
-            m_size          = {30, 30};
-            break;
-        case 38:
-            m_type = GameObjectType::UnknownType;
-            m_disabled       = true;
-            break;
-        case 41:
-            m_usePCol1               = true;
-            m_type                   = GameObjectType::UnknownType;
-            m_blendAdditive  = true;
-            m_disabled               = true;
-            break;
-        case 44:
-            m_type               = GameObjectType::UnknownType;
-            m_objectZ            = 2;
-            m_disabled           = true;
-            break;
-        case 45:
-            m_type = GameObjectType::MirrorPortal;
-            m_objectZ = 10;
-
-            if (ax::ParticleSystemQuad* particle = CREATE_PARTICLE("portalEffect02.plist", 3)) {
-                particle->setStartColor({1.0f, 150.0f / 255, 0.0f, 1.0f});
-                particle->setEndColor({1.0f, 150.0f / 255, 0.0f, 1.0f});
-            }
-
-            break;
-        case 46:
-            m_type  = GameObjectType::CounterMirrorPortal;
-            m_objectZ = 10;
-            CREATE_PARTICLE("portalEffect01.plist", 3);
-            break;
-        case 47:
-            m_type = GameObjectType::BallPortal;
-            m_objectZ = 10;
-
-            if (ax::ParticleSystemQuad* particle = CREATE_PARTICLE("portalEffect02.plist", 3)) {
-                particle->setStartColor({1.0f, 100.0f / 255, 0.0f, 1.0f});
-                particle->setEndColor({1.0f, 100.0f / 255, 0.0f, 1.0f});
-            }
-
-            break;
-        case 48:
-        case 49:
-            m_blendAdditive = true;
-            m_type          = GameObjectType::UnknownType;
-            m_objectZ       = 0;
-            m_disabled      = true;
-            m_usePCol2      = true;
-            break;
+    m_type          = traits.type;
+    m_scaleMod      = {traits.scaleModX, traits.scaleModY};
+    m_disabled      = traits.disabled;
+    m_blendAdditive = traits.blendAdditive;
+    m_usePCol1      = traits.usePCol1;
+    m_usePCol2      = traits.usePCol2;
+    m_isOrb         = traits.isOrb;
+    m_useAudioScale = traits.useAudioScale;
+    m_shouldSpawn   = traits.shouldSpawn;
+    m_isInvisible   = traits.isInvisible;
 
-        case 50:
-        case 51:
-        case 52:
-        case 53:
-        case 54:
-        case 60:
-            m_usePCol1 = 1;
-            m_type = GameObjectType::UnknownType2;
-            m_useAudioScale   = true;
-            m_blendAdditive = true;
-            m_disabled        = true;
-            m_size            = {30, 30};
-            break;
-        case 67:
-            m_type = GameObjectType::GravityPad;
-            m_scaleMod          = {1, 1};
+    if (traits.objectZ) {
+        m_objectZ = *traits.objectZ;
+    }
 
-            if (ax::ParticleSystemQuad* particle = CREATE_PARTICLE("bumpEffect.plist", 0)) {
-                particle->setStartColor({0.f, 1.f, 1.f, 1.f});
-                particle->setEndColor({0.f, 1.f, 1.f, 1.f});
-            }
+    if (traits.sizeOverride) {
+        m_size = {*traits.sizeOverride, *traits.sizeOverride};
+    }
 
-            break;
-        case 84:
-            m_type = GameObjectType::BlueOrb;
-            m_isOrb= 1;
-            m_useAudioScale= 1;
-            m_scaleMod              = {1.2, 1.2};
-            
-            if (ax::ParticleSystemQuad* particle = CREATE_PARTICLE("ringEffect.plist", 3)) {
-                particle->setStartColor({0.f, 1.f, 1.f, 1.f});
-                particle->setEndColor({0.f, 1.f, 1.f, 1.f});
-            }
+    if (!traits.particle.plist) {
+        return;
+    }
 
-            break;
-        default:
-            m_type = GameObjectType::None;
+    ax::ParticleSystemQuad* particle = createAndAddParticle(
+        static_cast<int>(m_type), traits.particle.plist, traits.particle.tag, ax::ParticleSystem::PositionType::GROUPED);
 
-            if (m_frame.starts_with("edit_e")) {
-                m_type        = GameObjectType::UnknownType;
-                m_shouldSpawn = true;
-                m_disabled    = true;
-                m_isInvisible = true;
-            }
-    };
+    if (particle && traits.particle.hasColor) {
+        const float* c = traits.particle.color;
 
-    return;
-#undef CREATE_PARTICLE
+        particle->setStartColor({c[0], c[1], c[2], c[3]});
+        particle->setEndColor({c[0], c[1], c[2], c[3]});
+    }
 }
 
 ax::Rect GameObject::getObjectRect(ax::Vec2 scale) const {
@@ -6,29 +6,27 @@
 #include <2d/ParticleSystemQuad.h>
 #include <2d/Sprite.h>
 
-enum class GameObjectType : int32_t {
-    None                = 0,
-    Hazard              = 2,
-    InvertGravityPortal = 3,
-    NormalGravityPortal = 4,
-    ShipPortal          = 5,
-    CubePortal          = 6,
-    UnknownType         = 7,
-    UnknownType2        = 8,
-    YellowPad           = 9,
-    GravityPad          = 10,
-    YellowOrb           = 11,
-    BlueOrb             = 12,
-    MirrorPortal        = 13,
-    CounterMirrorPortal = 14,
-    BallPortal          = 15
-};
-
-class GameObject : public ax::Sprite {
+#include "GameObjectType.h"
+#include "GlowBatchNode.h"
+#include "ObjectBatchNode.h"
+#include "ObjectDescriptor.h"
+#include "ObjectTraits.h"
+#include "ParticlePool.h"
+#include "Utils/ObjectArena.inl.h"
+
+class GameObject : public ax::Sprite, public ArenaAllocated<GameObject> {
 public:
-    ~GameObject();
-
     static GameObject* createFromString(std::string_view);
+    static GameObject* createFromDescriptor(const ObjectDescriptor&);
+
+    /**
+     * Loads `blocks.json` if it hasn't been loaded yet. Must happen on the main thread before
+     * `isKeyDefined` is used from other threads.
+     */
+    static void loadObjectDictionary();
+    static bool isKeyDefined(int objectKey);
+    static const std::string* frameForKey(int objectKey);
+    static ObjectTraits traitsForKey(int objectKey);
     static GameObject* create(std::string_view);
 
     void setRotation(float) override;
@@ -47,10 +45,10 @@ public:
     bool getDontTransform() const { return m_dontTransform; }
     bool getUseAudioScale() const { return m_useAudioScale; }
     bool getBlendAdditive() const { return m_blendAdditive; }
-    void setObjectParent(ax::Node* node) { m_objectParent = node; }
+    void setObjectParent(ObjectBatchNode* node) { m_objectParent = node; }
     bool getShouldSpawn() const { return m_shouldSpawn; }
     void calculateSpawnXPos();
-    std::string getFrame() const { return m_frame; }
+    const std::string& getFrame() const { return m_frame; }
     void setObjectKey(int id) { m_objectKey = id; };
 
     void setStartPosition(ax::Vec2 position)
@@ -65,6 +63,25 @@ public:
     void setSectionIdx(int idx) { m_sectionIdx = idx; }
     void activateObject();
     void deactivateObject();
+
+    /**
+     * Has `ObjectBatchNode` and `GlowBatchNode` redraw this object and its glow as they are now. Needed
+     * after every visual change of an active object, the batch nodes keep drawing the old quads otherwise.
+     */
+    void updateQuad();
+
+    /**
+     * Takes the object out of the scene right away and hands its particle back to the pool.
+     * Used when a lazily built section is dropped.
+     */
+    void releaseObject();
+
+    /**
+     * Prepares a released object for another placement of the same frame, see `GameObjectPool`.
+     * Traits, particle kind and glow stay as they are since they only depend on the frame.
+     */
+    void resetForReuse();
+    void reuseFromDescriptor(const ObjectDescriptor&);
     bool getShouldSpawn();
     float getSpawnXPos();
     virtual void triggerObject();
@@ -82,6 +99,24 @@ public:
 
     void setEnterAngle(float aangle) { m_enterAngle = aangle; }
     float getEnterAngle() const { return m_enterAngle; }
+
+    /**
+     * Whether the enter effect or angle changed since the last call, i.e. whether the coefficients
+     * in the object's `PlayScene::m_enterEffectBatch` entry are out of date.
+     */
+    bool takeEnterEffectChanged() {
+        bool changed         = m_coefficientsEffect != m_enterEffect || m_coefficientsAngle != m_enterAngle;
+        m_coefficientsEffect = m_enterEffect;
+        m_coefficientsAngle  = m_enterAngle;
+
+        return changed;
+    }
+
+    /**
+     * Index of the object's entry in `PlayScene::m_enterEffectBatch`, -1 while it has none.
+     */
+    int getEnterEffectSlot() const { return m_enterEffectSlot; }
+    void setEnterEffectSlot(int slot) { m_enterEffectSlot = slot; }
     bool getUsePlayerColor() const { return m_usePCol1; }
     bool getUsePlayerColor2() const { return m_usePCol2; }
 
@@ -93,21 +128,17 @@ public:
     void setPosition(const ax::Vec2& pos) override;
     void addGlow();
     virtual void resetObject();
-    void setScale(float) override;
-    void setScale(float, float) override;
-    void setScaleX(float) override;
-    void setScaleY(float) override;
-    
-    // note: unlike in the actual code, this is not a virtual function
-    void setFlippedX(bool);
-
-    // note: unlike in the actual code, this is not a virtual function
-    void setFlippedY(bool);
-
     void setOpacity(uint8_t opacity) override;
 
+    /**
+     * Null for objects without a glow. Drawn by `GlowBatchNode` with this object's transform, flips
+     * and opacity as of the last `updateQuad`, so nothing needs to be mirrored onto it.
+     */
+    const GlowBatchNode::Glow* getGlow() const { return m_glow; }
+
 protected:
     bool init(std::string_view texture);
+    void applyDescriptor(const ObjectDescriptor&);
 
 private:
     int m_objectKey; ///< The object or block id.
@@ -133,7 +164,7 @@ private:
     bool m_rotated; ///< States if the object is rotated sideways (90 or 270 degrees).
     GameObjectType m_type; ///< The object's type.
 
-    int m_objectZ;
+    int m_objectZ = 0;
     bool m_disabled;
     bool m_hasBeenActivated;
     bool m_blendAdditive;
@@ -150,14 +181,23 @@ private:
     float m_startRotation;
     float m_spawnXPos;
     bool m_shouldSpawn;
-    ax::Node* m_objectParent;
+    ObjectBatchNode* m_objectParent = nullptr; ///< Draws the object while it's active, see `ObjectBatchNode`.
     std::string m_frame;
     ax::Color3B m_tintColor;
     float m_tintDuration;
     int m_enterEffect;
     float m_enterAngle;
-    std::string m_particleKey;
+    int m_coefficientsEffect  = -1;
+    float m_coefficientsAngle = 0;
+    int m_enterEffectSlot     = -1;
+    ParticlePool::Id m_particleId = ParticlePool::INVALID;
     bool m_addedParticle;
     ax::ParticleSystemQuad* m_particleSystem;
-    ax::Sprite* m_glowSprite;
+    const GlowBatchNode::Glow* m_glow = nullptr; ///< Replaces `m_glowSprite`.
+    int m_glowIndex                   = -1;      ///< Position in `GlowBatchNode`, -1 while not drawn.
+    int m_batchSection                = 0;       ///< Section `m_objectParent` files the object under.
+    int m_batchIndex                  = -1;      ///< Position in that section of `m_objectParent`, -1 while not drawn.
+
+    friend class GlowBatchNode;
+    friend class ObjectBatchNode;
 };
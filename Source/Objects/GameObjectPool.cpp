@@ -0,0 +1,72 @@
+#include "GameObjectPool.h"
+#include "GameObject.h"
+
+GameObjectPool::~GameObjectPool() {
+    clear();
+}
+
+GameObject* GameObjectPool::createFromDescriptor(const ObjectDescriptor& desc) {
+    const std::string* frame = GameObject::frameForKey(desc.objectKey);
+
+    if (!frame) {
+        return nullptr;
+    }
+
+    if (GameObject* object = takePooled(*frame)) {
+        object->reuseFromDescriptor(desc);
+        return object;
+    }
+
+    return GameObject::createFromDescriptor(desc);
+}
+
+GameObject* GameObjectPool::create(std::string_view frame) {
+    if (GameObject* object = takePooled(frame)) {
+        object->resetForReuse();
+        return object;
+    }
+
+    return GameObject::create(frame);
+}
+
+void GameObjectPool::recycle(GameObject* object) {
+    object->releaseObject();
+    object->retain();
+
+    auto it = m_pool.find(std::string_view(object->getFrame()));
+
+    if (it == m_pool.end()) {
+        it = m_pool.emplace(object->getFrame(), std::vector<GameObject*>()).first;
+    }
+
+    it->second.push_back(object);
+    m_pooledCount++;
+}
+
+void GameObjectPool::clear() {
+    for (auto& [frame, objects] : m_pool) {
+        for (GameObject* object : objects) {
+            object->release();
+        }
+    }
+
+    m_pool.clear();
+    m_pooledCount = 0;
+}
+
+GameObject* GameObjectPool::takePooled(std::string_view frame) {
+    auto it = m_pool.find(frame);
+
+    if (it == m_pool.end() || it->second.empty()) {
+        return nullptr;
+    }
+
+    GameObject* object = it->second.back();
+    it->second.pop_back();
+    m_pooledCount--;
+
+    // Hand the pool's reference over, same as a freshly created object.
+    object->autorelease();
+
+    return object;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "ObjectDescriptor.h"
+
+class GameObject;
+
+/**
+ * Keeps released `GameObject`s around so a section scrolling back in reuses nodes instead of
+ * allocating new ones. Objects are recycled per frame name, since the frame decides everything
+ * that is expensive to set up (texture, glow frame, traits, particle kind).
+ *
+ * Owned by `PlayScene`, whatever is still pooled is released with it.
+ */
+class GameObjectPool {
+public:
+    GameObjectPool() = default;
+    ~GameObjectPool();
+
+    GameObjectPool(const GameObjectPool&)            = delete;
+    GameObjectPool& operator=(const GameObjectPool&) = delete;
+
+    /**
+     * Same as `GameObject::createFromDescriptor`, but takes a pooled object when there is one.
+     * The returned object is autoreleased either way.
+     */
+    GameObject* createFromDescriptor(const ObjectDescriptor&);
+
+    /**
+     * Same as `GameObject::create`. The caller sets the object up, see `GameObject::resetForReuse`.
+     */
+    GameObject* create(std::string_view frame);
+
+    /**
+     * Takes `object` out of the scene and keeps it for later. The caller can drop its reference.
+     */
+    void recycle(GameObject* object);
+
+    void clear();
+
+    size_t getPooledCount() const { return m_pooledCount; }
+
+private:
+    GameObject* takePooled(std::string_view frame);
+
+private:
+    struct FrameHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view str) const { return std::hash<std::string_view>()(str); }
+    };
+
+    std::unordered_map<std::string, std::vector<GameObject*>, FrameHash, std::equal_to<>> m_pool;
+    size_t m_pooledCount = 0;
+};
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+enum class GameObjectType : int32_t {
+    None                = 0,
+    Hazard              = 2,
+    InvertGravityPortal = 3,
+    NormalGravityPortal = 4,
+    ShipPortal          = 5,
+    CubePortal          = 6,
+    UnknownType         = 7,
+    UnknownType2        = 8,
+    YellowPad           = 9,
+    GravityPad          = 10,
+    YellowOrb           = 11,
+    BlueOrb             = 12,
+    MirrorPortal        = 13,
+    CounterMirrorPortal = 14,
+    BallPortal          = 15
+};
@@ -0,0 +1,140 @@
+#include "GlowBatchNode.h"
+#include "GameObject.h"
+
+#include <2d/Sprite.h>
+#include <base/Utils.h>
+#include <renderer/TextureAtlas.h>
+
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+
+GlowBatchNode* GlowBatchNode::create(std::string_view spriteSheet) {
+    auto node = ax::utils::createInstance<GlowBatchNode>(&GlowBatchNode::initWithFile, spriteSheet, DEFAULT_CAPACITY);
+
+    if (node) {
+        node->setBlendFunc(ax::BlendFunc::ADDITIVE);
+    }
+
+    return node;
+}
+
+const GlowBatchNode::Glow* GlowBatchNode::glowForFrame(const std::string& frame) {
+    static std::unordered_map<std::string, std::unique_ptr<Glow>> glows;
+
+    if (auto it = glows.find(frame); it != glows.end()) {
+        return it->second.get();
+    }
+
+    std::unique_ptr<Glow> glow;
+
+    if (ax::Sprite* sprite = ax::Sprite::createWithSpriteFrameName(frame)) {
+        glow = std::make_unique<Glow>();
+        glow->anchorInPoints     = sprite->getAnchorPointInPoints();
+        glow->premultipliedAlpha = sprite->getTexture()->hasPremultipliedAlpha();
+
+        for (int flips = 0; flips < 4; flips++) {
+            sprite->setFlippedX(flips & 1);
+            sprite->setFlippedY(flips & 2);
+            glow->quads[flips] = sprite->getQuad();
+        }
+    }
+
+    return glows.emplace(frame, std::move(glow)).first->second.get();
+}
+
+ax::V3F_C4B_T2F_Quad GlowBatchNode::quadForObject(GameObject* object) {
+    const Glow* glow = object->getGlow();
+
+    // The object's transform, with the glow's anchor in place of the object's.
+    ax::Mat4 glowTransform = object->getNodeToParentTransform();
+    ax::Vec2 anchorOffset  = object->getAnchorPointInPoints() - glow->anchorInPoints;
+    glowTransform.translate(anchorOffset.x, anchorOffset.y, 0);
+
+    ax::V3F_C4B_T2F_Quad quad = glow->quads[(object->isFlippedX() ? 1 : 0) | (object->isFlippedY() ? 2 : 0)];
+
+    // Additive, so a hidden object's glow just adds nothing.
+    uint8_t opacity = object->isVisible() ? object->getOpacity() : 0;
+    ax::Color4B color =
+        glow->premultipliedAlpha ? ax::Color4B(opacity, opacity, opacity, opacity) : ax::Color4B(255, 255, 255, opacity);
+
+    for (ax::V3F_C4B_T2F* vertex : {&quad.bl, &quad.br, &quad.tl, &quad.tr}) {
+        glowTransform.transformPoint(&vertex->vertices);
+        vertex->colors = color;
+    }
+
+    return quad;
+}
+
+void GlowBatchNode::addObject(GameObject* object) {
+    if (object->m_glowIndex >= 0 || !object->getGlow()) {
+        return;
+    }
+
+    object->m_glowIndex = static_cast<int>(m_objects.size());
+    m_objects.push_back(object);
+    m_quads.push_back(quadForObject(object));
+    m_layoutDirty = true;
+}
+
+void GlowBatchNode::removeObject(GameObject* object) {
+    int index = object->m_glowIndex;
+
+    if (index < 0) {
+        return;
+    }
+
+    m_objects[index]              = m_objects.back();
+    m_quads[index]                = m_quads.back();
+    m_objects[index]->m_glowIndex = index;
+    m_objects.pop_back();
+    m_quads.pop_back();
+    object->m_glowIndex = -1;
+    m_layoutDirty       = true;
+}
+
+void GlowBatchNode::updateObject(GameObject* object) {
+    if (object->m_glowIndex < 0) {
+        return;
+    }
+
+    ax::V3F_C4B_T2F_Quad& quad   = m_quads[object->m_glowIndex];
+    ax::V3F_C4B_T2F_Quad updated = quadForObject(object);
+
+    if (std::memcmp(&quad, &updated, sizeof(quad)) == 0) {
+        return;
+    }
+
+    quad = updated;
+
+    // Until the next layout the atlas is stale anyway, it gets the new quad then.
+    if (!m_layoutDirty) {
+        _textureAtlas->updateQuad(quad, object->m_glowIndex);
+    }
+}
+
+void GlowBatchNode::layoutAtlas() {
+    _textureAtlas->removeAllQuads();
+
+    if (_textureAtlas->getCapacity() < static_cast<ssize_t>(m_quads.size())) {
+        _textureAtlas->resizeCapacity(m_quads.size() * 4 / 3 + 1);
+    }
+
+    if (!m_quads.empty()) {
+        _textureAtlas->insertQuads(m_quads.data(), 0, static_cast<ssize_t>(m_quads.size()));
+    }
+
+    m_layoutDirty = false;
+}
+
+void GlowBatchNode::draw(ax::Renderer* renderer, const ax::Mat4& transform, uint32_t flags) {
+    if (m_layoutDirty) {
+        layoutAtlas();
+    }
+
+    if (_textureAtlas->getTotalQuads() == 0) {
+        return;
+    }
+
+    SpriteBatchNode::draw(renderer, transform, flags);
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <2d/SpriteBatchNode.h>
+
+class GameObject;
+
+/**
+ * Draws the glow of every active object as one extra quad per object, all in the draw call of this
+ * node, instead of a `Sprite` per glow that mirrored every transform change of its object.
+ *
+ * Like `ObjectBatchNode`, each glow quad is built from its object's transform, flips and opacity when
+ * the object is added and kept until `updateObject` is called for it, which `GameObject::updateQuad`
+ * does along with the object's own quad. `GameObject::activateObject` registers objects with a glow
+ * and `deactivateObject` drops them again.
+ *
+ * The atlas is only laid out again when objects are added or removed, `updateObject` writes a changed
+ * quad straight into it. Blends additively, so the order of the quads doesn't matter.
+ */
+class GlowBatchNode : public ax::SpriteBatchNode {
+public:
+    /**
+     * One glow frame, ready to be placed on an object.
+     */
+    struct Glow {
+        ax::V3F_C4B_T2F_Quad quads[4]; ///< In the glow's own space, indexed by `flippedX | flippedY << 1`.
+        ax::Vec2 anchorInPoints;
+        bool premultipliedAlpha;
+    };
+
+    static GlowBatchNode* create(std::string_view spriteSheet);
+
+    /**
+     * Null if there is no sprite frame `frame`. Cached for the rest of the run.
+     */
+    static const Glow* glowForFrame(const std::string& frame);
+
+    void addObject(GameObject* object);
+    void removeObject(GameObject* object);
+
+    /**
+     * Rebuilds the glow quad of an added object from its current transform, flips, opacity and visibility.
+     */
+    void updateObject(GameObject* object);
+
+    void draw(ax::Renderer* renderer, const ax::Mat4& transform, uint32_t flags) override;
+
+private:
+    static ax::V3F_C4B_T2F_Quad quadForObject(GameObject* object);
+
+    /**
+     * Copies `m_quads` into the atlas.
+     */
+    void layoutAtlas();
+
+    std::vector<GameObject*> m_objects;
+    std::vector<ax::V3F_C4B_T2F_Quad> m_quads; ///< Same order as `m_objects`, and as the atlas after a layout.
+
+    bool m_layoutDirty = false; ///< Objects were added or removed since the last `layoutAtlas`.
+};
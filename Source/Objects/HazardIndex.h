@@ -0,0 +1,89 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "CollisionSection.h"
+
+/**
+ * Hitboxes of every hazard, kept apart from the other objects so `PlayScene::checkCollisions`
+ * doesn't have to pick them out of the sections again on every substep.
+ *
+ * Uses the same X sections as `PlayScene::m_sections`. Inside a section the rects are sorted by
+ * their bottom edge, so a query only looks at the hazards whose vertical range can reach the rect.
+ * Hazards are added when their object is placed (see `PlayScene::addToSection`), which is when
+ * `GameObject::customSetup` has classified them.
+ */
+class HazardIndex {
+public:
+    void resize(size_t sectionCount) {
+        m_sections.resize(sectionCount);
+    }
+
+    size_t size() const { return m_sections.size(); }
+
+    void add(int section, const CollisionRect& rect) {
+        Section& entry = m_sections[section];
+
+        auto it = std::upper_bound(entry.rects.begin(), entry.rects.end(), rect.minY,
+            [](float minY, const CollisionRect& other) { return minY < other.minY; });
+        entry.rects.insert(it, rect);
+
+        entry.maxHeight = std::max(entry.maxHeight, rect.maxY - rect.minY);
+    }
+
+    void clearSection(int section) {
+        m_sections[section].rects.clear();
+        m_sections[section].maxHeight = 0;
+    }
+
+    void clear() {
+        m_sections.clear();
+    }
+
+    size_t getSectionHazardCount(int section) const {
+        return m_sections[section].rects.size();
+    }
+
+    /**
+     * Calls `callback(const CollisionRect&)` for every hazard of sections `[firstSection, lastSection]`
+     * that intersects `rect`. Stops early and returns true as soon as the callback returns true.
+     */
+    template <typename Callback>
+    bool query(int firstSection, int lastSection, const CollisionRect& rect, Callback&& callback) const {
+        firstSection = std::max(firstSection, 0);
+        lastSection  = std::min(lastSection, static_cast<int>(m_sections.size()) - 1);
+
+        for (int i = firstSection; i <= lastSection; i++) {
+            const Section& section = m_sections[i];
+
+            if (section.rects.empty()) {
+                continue;
+            }
+
+            // Anything starting below this can't reach up to `rect` (plus a unit of slack for rounding).
+            auto first = std::lower_bound(section.rects.begin(), section.rects.end(), rect.minY - section.maxHeight - 1,
+                [](const CollisionRect& other, float minY) { return other.minY < minY; });
+
+            for (auto it = first; it != section.rects.end() && !(rect.maxY < it->minY); ++it) {
+                if (it->intersects(rect) && callback(*it)) {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    bool intersectsAny(int firstSection, int lastSection, const CollisionRect& rect) const {
+        return query(firstSection, lastSection, rect, [](const CollisionRect&) { return true; });
+    }
+
+private:
+    struct Section {
+        std::vector<CollisionRect> rects; ///< Sorted by `minY`.
+        float maxHeight = 0;              ///< Tallest rect, bounds how far below `rect` a match can start.
+    };
+
+    std::vector<Section> m_sections;
+};
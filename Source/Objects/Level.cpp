@@ -1,7 +1,57 @@
 #include "Level.h"
+#include "Utils/MappedFile.inl.h"
+
+#include <platform/FileUtils.h>
+
+Level::~Level() = default;
 
 Level* Level::create() {
     auto p = new Level();
     p->autorelease();
     return p;
 }
+
+Level* Level::createFromFile(std::string_view path) {
+    auto p = new Level();
+
+    if (!p->initWithFile(path)) {
+        delete p;
+        return nullptr;
+    }
+
+    p->autorelease();
+    return p;
+}
+
+bool Level::initWithFile(std::string_view path) {
+    ax::FileUtils* const fileUtils = ax::FileUtils::getInstance();
+    std::string fullPath           = fileUtils->fullPathForFilename(path);
+
+    if (fullPath.empty()) {
+        return false;
+    }
+
+    auto mappedFile = std::make_unique<MappedFile>();
+
+    if (mappedFile->open(fullPath) && level_format::is_binary_level(mappedFile->getData())) {
+        if (!m_binaryView.init(mappedFile->getData())) {
+            return false;
+        }
+
+        m_isBinary   = true;
+        m_mappedFile = std::move(mappedFile);
+        return true;
+    }
+
+    // Not mappable (packed assets) or a text level.
+    if (fileUtils->getContents(fullPath, &m_levelData) != ax::FileUtils::Status::OK) {
+        return false;
+    }
+
+    if (level_format::is_binary_level(m_levelData)) {
+        m_isBinary = m_binaryView.init(m_levelData);
+        return m_isBinary;
+    }
+
+    return true;
+}
@@ -1,14 +1,36 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include <base/Object.h>
 
+#include "Utils/LevelFormat.inl.h"
+
+class MappedFile;
+
 class Level : public ax::Object {
 public:
+    ~Level();
+
     static Level* create();
 
+    /**
+     * Loads a level file. Binary levels (see `level_format`) are memory-mapped when possible,
+     * anything else is treated as the text format.
+     */
+    static Level* createFromFile(std::string_view path);
+
     const std::string& getLevelData() const { return m_levelData; }
     void setLevelData(std::string_view sv) { m_levelData = sv; }
+
+    bool isBinary() const { return m_isBinary; }
+    const level_format::View& getBinaryView() const { return m_binaryView; }
+private:
+    bool initWithFile(std::string_view path);
 private:
-    std::string m_levelData;
+    std::string m_levelData; ///< Text level, or the binary level when it couldn't be mapped.
+
+    bool m_isBinary = false;
+    std::unique_ptr<MappedFile> m_mappedFile;
+    level_format::View m_binaryView;
 };
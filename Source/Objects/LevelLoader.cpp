@@ -0,0 +1,163 @@
+#include "LevelLoader.h"
+#include "GameObject.h"
+#include "Level.h"
+#include "Utils/LevelTokenizer.inl.h"
+#include "Utils/Trace.inl.h"
+
+#include <algorithm>
+
+LevelLoader::~LevelLoader() {
+    cancel();
+}
+
+void LevelLoader::start(Level* level) {
+    cancel();
+
+    level->retain();
+    m_level = level;
+
+    m_cancelled = false;
+    m_thread    = std::thread(&LevelLoader::run, this);
+}
+
+void LevelLoader::cancel() {
+    m_cancelled = true;
+
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    if (m_level) {
+        m_level->release();
+        m_level = nullptr;
+    }
+}
+
+bool LevelLoader::getLevelInfo(LevelInfo& info) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_hasInfo) {
+        return false;
+    }
+
+    info = m_info;
+    return true;
+}
+
+bool LevelLoader::popBatch(SectionBatch& batch) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_batches.empty()) {
+        return false;
+    }
+
+    batch = std::move(m_batches.front());
+    m_batches.pop_front();
+    m_batchesTaken++;
+
+    return true;
+}
+
+bool LevelLoader::isFinished() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_workerDone && m_batches.empty();
+}
+
+void LevelLoader::collectDescriptors(std::vector<std::vector<ObjectDescriptor>>& sections) {
+    auto addDescriptor = [&sections](const ObjectDescriptor& desc) {
+        if (!GameObject::isKeyDefined(desc.objectKey)) {
+            return;
+        }
+
+        size_t section = static_cast<size_t>(std::max(level_format::section_for_x(desc.x), 0));
+
+        if (sections.size() <= section) {
+            sections.resize(section + 1);
+        }
+
+        sections[section].push_back(desc);
+    };
+
+    if (m_level->isBinary()) {
+        const level_format::View& view = m_level->getBinaryView();
+        sections.reserve(view.getSections().size());
+
+        for (const level_format::ObjectRecord& record : view.getObjects()) {
+            if (m_cancelled.load(std::memory_order_relaxed)) {
+                return;
+            }
+
+            addDescriptor(level_format::to_descriptor(record));
+        }
+    } else {
+        auto [header, data] = level_tokenizer::split_header(m_level->getLevelData());
+        level_tokenizer::for_each_object(data, [&](const ObjectDescriptor& desc) {
+            if (m_cancelled.load(std::memory_order_relaxed)) {
+                return false;
+            }
+
+            addDescriptor(desc);
+            return true;
+        });
+    }
+}
+
+void LevelLoader::publish(SectionBatch&& batch) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_batches.push_back(std::move(batch));
+}
+
+void LevelLoader::run() {
+    TRACE_THREAD_NAME("LevelLoader");
+    TRACE_SCOPE("LevelLoader::run");
+
+    std::vector<std::vector<ObjectDescriptor>> sections;
+    collectDescriptors(sections);
+
+    LevelInfo info;
+    info.sectionCount = sections.size();
+
+    for (const auto& section : sections) {
+        for (const ObjectDescriptor& desc : section) {
+            // Same rule as PlayScene::createObjectFromDescriptor: the furthest start position wins.
+            if (desc.objectKey == 31 && (!info.hasStartPos || desc.x > info.startX)) {
+                info.startX      = desc.x;
+                info.startY      = desc.y;
+                info.hasStartPos = true;
+            }
+        }
+    }
+
+    // Hand the sections over starting just behind the start position, then the rest of the
+    // level in order, then whatever is behind the start.
+    int startSection = info.hasStartPos ? level_format::section_for_x(info.startX) : 0;
+    int sectionCount = static_cast<int>(sections.size());
+    int firstSection = std::clamp(startSection - 1, 0, sectionCount);
+    int windowEnd    = std::clamp(startSection + START_WINDOW_SECTIONS + 1, firstSection, sectionCount);
+
+    m_startWindowBatches = std::count_if(sections.begin() + firstSection, sections.begin() + windowEnd,
+                                         [](const auto& section) { return !section.empty(); });
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_info    = info;
+        m_hasInfo = true;
+    }
+
+    auto sendSection = [this, &sections](int section) {
+        if (!sections[section].empty()) {
+            publish({section, std::move(sections[section])});
+        }
+    };
+
+    for (int i = firstSection; i < sectionCount && !m_cancelled; i++) {
+        sendSection(i);
+    }
+
+    for (int i = firstSection - 1; i >= 0 && !m_cancelled; i--) {
+        sendSection(i);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_workerDone = true;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ObjectDescriptor.h"
+
+class Level;
+
+/**
+ * Turns a level into object descriptors on a worker thread.
+ *
+ * The worker buckets every object into its section and hands the sections over one at a time,
+ * starting with the sections around the start position so the game can begin before the tail of
+ * the level has been built. Creating the actual nodes is left to the caller on the main thread.
+ */
+class LevelLoader {
+public:
+    struct SectionBatch {
+        int section;
+        std::vector<ObjectDescriptor> objects;
+    };
+
+    struct LevelInfo {
+        size_t sectionCount = 0;
+        float startX        = 0; ///< X of the furthest start position object, 0 if there is none.
+        float startY        = 0;
+        bool hasStartPos    = false;
+    };
+
+    /**
+     * Number of sections after the start section that are handed over first, on top of one
+     * section behind it. Covers the widest screen we support plus the visibility margin.
+     */
+    static constexpr int START_WINDOW_SECTIONS = 24;
+
+    LevelLoader() = default;
+    ~LevelLoader();
+
+    LevelLoader(const LevelLoader&)            = delete;
+    LevelLoader& operator=(const LevelLoader&) = delete;
+
+    /**
+     * Starts parsing `level`. The level is retained until the loader is destroyed.
+     * `GameObject`'s block dictionary must already be loaded, see `GameObject::isKeyDefined`.
+     */
+    void start(Level* level);
+
+    /**
+     * Stops the worker as soon as possible and waits for it.
+     */
+    void cancel();
+
+    /**
+     * Returns true once the worker has bucketed the level, `info` is only valid after that.
+     */
+    bool getLevelInfo(LevelInfo& info);
+
+    /**
+     * Takes the next finished section, if any. Never blocks on the worker.
+     */
+    bool popBatch(SectionBatch& batch);
+
+    /**
+     * True once the sections around the start position have been taken with `popBatch`.
+     */
+    bool isStartWindowReady() const { return m_batchesTaken >= m_startWindowBatches.load(); }
+
+    /**
+     * True once every section has been produced and taken.
+     */
+    bool isFinished();
+
+private:
+    void run();
+    void collectDescriptors(std::vector<std::vector<ObjectDescriptor>>& sections);
+    void publish(SectionBatch&& batch);
+
+private:
+    Level* m_level = nullptr;
+    std::thread m_thread;
+    std::atomic<bool> m_cancelled {false};
+
+    std::mutex m_mutex;
+    std::deque<SectionBatch> m_batches;
+    LevelInfo m_info;
+    bool m_hasInfo    = false;
+    bool m_workerDone = false;
+
+    std::atomic<size_t> m_startWindowBatches {SIZE_MAX};
+    size_t m_batchesTaken = 0; ///< Main thread only.
+};
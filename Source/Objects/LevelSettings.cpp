@@ -1,43 +1,39 @@
 #include "LevelSettings.h"
-#include "Utils/SplitString.inl.h"
+#include "Utils/LevelTokenizer.inl.h"
 
 LevelSettings* LevelSettings::objectFromString(std::string_view str) {
     auto settings = new LevelSettings();
     settings->autorelease();
 
-    auto arr = split_string::split(str, ",");
-    std::string key;
+    level_tokenizer::for_each_pair(str, [settings](std::string_view key, std::string_view item) {
+        int value = 0;
 
-    for (auto& item : arr) {
-        if (key.empty()) {
-            key = item;
-            continue;
+        if (!level_tokenizer::parse_int(item, value)) {
+            return;
         }
 
         if (key == "kS1") {
-            settings->m_backgroundColor.r = std::stoi(item);
+            settings->m_backgroundColor.r = value;
         }
         else if (key == "kS2") {
-            settings->m_backgroundColor.g = std::stoi(item);
+            settings->m_backgroundColor.g = value;
         }
         else if (key == "kS3") {
-            settings->m_backgroundColor.b = std::stoi(item);
+            settings->m_backgroundColor.b = value;
         }
         else if (key == "kS4") {
-            settings->m_groundColor.r = std::stoi(item);
+            settings->m_groundColor.r = value;
         }
         else if (key == "kS5") {
-            settings->m_groundColor.g = std::stoi(item);
+            settings->m_groundColor.g = value;
         }
         else if (key == "kS6") {
-            settings->m_groundColor.b = std::stoi(item);
+            settings->m_groundColor.b = value;
         }
         else if (key == "kA1") {
-            settings->m_soundtrackId = std::stoi(item);
+            settings->m_soundtrackId = value;
         }
-
-        key = "";
-    }
+    });
 
     return settings;
 }
@@ -0,0 +1,168 @@
+#include "ObjectBatchNode.h"
+#include "GameObject.h"
+
+#include <base/Utils.h>
+#include <renderer/TextureAtlas.h>
+
+#include <algorithm>
+#include <cstring>
+
+ObjectBatchNode* ObjectBatchNode::create(std::string_view spriteSheet) {
+    return ax::utils::createInstance<ObjectBatchNode>(&ObjectBatchNode::initWithFile, spriteSheet, DEFAULT_CAPACITY);
+}
+
+ObjectBatchNode::Layer* ObjectBatchNode::Section::layerForZ(int z) {
+    auto it = std::find_if(layers.begin(), layers.end(), [z](const Layer& layer) { return layer.z == z; });
+    return (it != layers.end()) ? &*it : nullptr;
+}
+
+ax::V3F_C4B_T2F_Quad ObjectBatchNode::quadForObject(GameObject* object) {
+    // Objects aren't in any batch node, so their quad is in their own space with flips and colors applied.
+    ax::V3F_C4B_T2F_Quad quad = object->getQuad();
+    const ax::Mat4& transform = object->getNodeToParentTransform();
+
+    for (ax::V3F_C4B_T2F* vertex : {&quad.bl, &quad.br, &quad.tl, &quad.tr}) {
+        transform.transformPoint(&vertex->vertices);
+    }
+
+    return quad;
+}
+
+void ObjectBatchNode::addObject(GameObject* object) {
+    if (object->m_batchIndex >= 0) {
+        return;
+    }
+
+    int section = std::max(object->m_sectionIdx, 0);
+    int z       = object->m_objectZ;
+
+    if (section >= static_cast<int>(m_sections.size())) {
+        m_sections.resize(section + 1);
+    }
+
+    if (auto it = std::lower_bound(m_zOrders.begin(), m_zOrders.end(), z); it == m_zOrders.end() || *it != z) {
+        m_zOrders.insert(it, z);
+    }
+
+    Layer* layer = m_sections[section].layerForZ(z);
+
+    if (!layer) {
+        layer = &m_sections[section].layers.emplace_back(Layer {z, {}, {}});
+    }
+
+    object->m_batchSection = section;
+    object->m_batchIndex   = static_cast<int>(layer->objects.size());
+    layer->objects.push_back(object);
+    layer->quads.push_back(quadForObject(object));
+
+    if (m_firstSection > m_lastSection) {
+        m_firstSection = m_lastSection = section;
+    } else {
+        m_firstSection = std::min(m_firstSection, section);
+        m_lastSection  = std::max(m_lastSection, section);
+    }
+
+    m_layoutDirty = true;
+}
+
+void ObjectBatchNode::removeObject(GameObject* object) {
+    int index = object->m_batchIndex;
+
+    if (index < 0) {
+        return;
+    }
+
+    Layer* layer = m_sections[object->m_batchSection].layerForZ(object->m_objectZ);
+
+    // Erased rather than swapped with the last one, overlapping objects of the same z would change
+    // places otherwise.
+    layer->objects.erase(layer->objects.begin() + index);
+    layer->quads.erase(layer->quads.begin() + index);
+
+    for (size_t i = index; i < layer->objects.size(); i++) {
+        layer->objects[i]->m_batchIndex = static_cast<int>(i);
+    }
+
+    object->m_batchIndex = -1;
+    m_layoutDirty        = true;
+}
+
+void ObjectBatchNode::updateObject(GameObject* object) {
+    if (object->m_batchIndex < 0) {
+        return;
+    }
+
+    Layer* layer                 = m_sections[object->m_batchSection].layerForZ(object->m_objectZ);
+    ax::V3F_C4B_T2F_Quad& quad   = layer->quads[object->m_batchIndex];
+    ax::V3F_C4B_T2F_Quad updated = quadForObject(object);
+
+    if (std::memcmp(&quad, &updated, sizeof(quad)) == 0) {
+        return;
+    }
+
+    quad = updated;
+
+    // Until the next layout the atlas still has the old quad at the old place, patch it there.
+    if (!m_layoutDirty) {
+        _textureAtlas->updateQuad(quad, layer->atlasOffset + object->m_batchIndex);
+    }
+}
+
+void ObjectBatchNode::layoutAtlas() {
+    auto isEmpty = [this](int section) {
+        return std::all_of(m_sections[section].layers.begin(), m_sections[section].layers.end(),
+                           [](const Layer& layer) { return layer.objects.empty(); });
+    };
+
+    while (m_firstSection <= m_lastSection && isEmpty(m_firstSection)) {
+        m_firstSection++;
+    }
+
+    while (m_lastSection >= m_firstSection && isEmpty(m_lastSection)) {
+        m_lastSection--;
+    }
+
+    _textureAtlas->removeAllQuads();
+
+    size_t total = 0;
+
+    for (int section = m_firstSection; section <= m_lastSection; section++) {
+        for (const Layer& layer : m_sections[section].layers) {
+            total += layer.quads.size();
+        }
+    }
+
+    if (_textureAtlas->getCapacity() < static_cast<ssize_t>(total)) {
+        _textureAtlas->resizeCapacity(total * 4 / 3 + 1);
+    }
+
+    ssize_t count = 0;
+
+    for (int z : m_zOrders) {
+        for (int section = m_firstSection; section <= m_lastSection; section++) {
+            Layer* layer = m_sections[section].layerForZ(z);
+
+            if (!layer || layer->quads.empty()) {
+                continue;
+            }
+
+            layer->atlasOffset = count;
+            _textureAtlas->insertQuads(layer->quads.data(), count, static_cast<ssize_t>(layer->quads.size()));
+            count += static_cast<ssize_t>(layer->quads.size());
+        }
+    }
+
+    m_layoutDirty = false;
+}
+
+void ObjectBatchNode::draw(ax::Renderer* renderer, const ax::Mat4& transform, uint32_t flags) {
+    if (m_layoutDirty) {
+        layoutAtlas();
+    }
+
+    if (_textureAtlas->getTotalQuads() == 0) {
+        return;
+    }
+
+    SpriteBatchNode::draw(renderer, transform, flags);
+}
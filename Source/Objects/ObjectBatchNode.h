@@ -0,0 +1,72 @@
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+#include <2d/SpriteBatchNode.h>
+
+class GameObject;
+
+/**
+ * Draws every active object of a blend mode without the objects being children of it. Replaces the
+ * `addChild`/`removeChild` calls `GameObject::activateObject` and `deactivateObject` used to make on a
+ * plain `SpriteBatchNode`, which reordered its children and moved its quads around every time.
+ *
+ * Each section keeps the quads of its active objects, one list per z order, in the order the objects
+ * were activated. A quad is built when its object is activated and stays as it is until
+ * `updateObject` is called for it, which `PlayScene` only does for the objects whose fade, enter
+ * effect or flip it just changed.
+ *
+ * The atlas is only laid out again when objects are added or removed. `updateObject` writes the one
+ * quad that changed straight into it, and frames where nothing changed draw the atlas as it is.
+ *
+ * Draws lower z orders first, sections left to right within a z order and activation order within a
+ * section.
+ */
+class ObjectBatchNode : public ax::SpriteBatchNode {
+public:
+    static ObjectBatchNode* create(std::string_view spriteSheet);
+
+    void addObject(GameObject* object);
+    void removeObject(GameObject* object);
+
+    /**
+     * Rebuilds the quad of an active object from its current transform, flips, color and opacity.
+     */
+    void updateObject(GameObject* object);
+
+    void draw(ax::Renderer* renderer, const ax::Mat4& transform, uint32_t flags) override;
+
+private:
+    struct Layer {
+        int z;
+        std::vector<GameObject*> objects;
+        std::vector<ax::V3F_C4B_T2F_Quad> quads; ///< Same order as `objects`.
+        ssize_t atlasOffset = 0;                 ///< Where `quads` start in the atlas since the last layout.
+    };
+
+    struct Section {
+        std::vector<Layer> layers; ///< Usually only one or two, in no particular order.
+
+        Layer* layerForZ(int z);
+    };
+
+    static ax::V3F_C4B_T2F_Quad quadForObject(GameObject* object);
+
+    /**
+     * Copies every list into the atlas and notes where each one went.
+     */
+    void layoutAtlas();
+
+    std::vector<Section> m_sections;
+    std::vector<int> m_zOrders; ///< Every z order used so far, sorted.
+
+    /**
+     * Every section with an active object is in this range. Grows in `addObject` and shrinks back to
+     * the sections that are still in use in `layoutAtlas`.
+     */
+    int m_firstSection = 0;
+    int m_lastSection  = -1;
+
+    bool m_layoutDirty = false; ///< Objects were added or removed since the last `layoutAtlas`.
+};
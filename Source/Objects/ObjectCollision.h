@@ -0,0 +1,287 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "CollisionSection.h"
+#include "GameObjectType.h"
+#include "HazardIndex.h"
+#include "SpatialGrid.h"
+#include "Utils/RectOverlap.inl.h"
+
+/**
+ * Engine-free half of `PlayScene::checkCollisions`: finds the objects and hazards the player runs
+ * into and decides what each object does to the player. `PlayScene` and `tombstone-sim` each own one
+ * next to their `SpatialGrid` and carry the decisions out through `ObjectCollision::Host`, the same
+ * way `PlayerPhysics` is shared for the player.
+ *
+ * `Handle` is whatever the grid stores, a `GameObject*` in the game and an index in the simulator.
+ */
+template <typename Handle>
+class ObjectCollision {
+public:
+    /**
+     * The owner's side: where the player is and what happens to it. Resolving a hit may move the
+     * player, the next hits are tested against `getPlayerRect` again.
+     */
+    class Host {
+    public:
+        virtual ~Host() = default;
+
+        virtual CollisionRect getPlayerRect() const = 0;
+        virtual bool getGravityFlipped() const = 0;
+
+        virtual bool isObjectActivated(Handle object) const = 0;
+        virtual void setObjectActivated(Handle object) = 0;
+        virtual float getObjectRotation(Handle object) const = 0;
+        virtual bool isObjectFlippedY(Handle object) const = 0;
+
+        virtual void onGravityPortal(Handle portal, bool flip) = 0;
+        virtual void onShipPortal(Handle portal) = 0;
+        virtual void onBallPortal(Handle portal) = 0;
+        virtual void onCubePortal(Handle portal) = 0;
+        virtual void onMirrorPortal(Handle portal, bool mirrored) = 0;
+
+        /**
+         * Launched by `pad`, with gravity ending up as `gravityFlipped` (which is the current one
+         * unless the pad flips it).
+         */
+        virtual void onPad(Handle pad, float force, bool gravityFlipped) = 0;
+
+        /**
+         * Touching `orb`, the owner jumps off it if the button was pressed for it.
+         */
+        virtual void onOrb(Handle orb, GameObjectType type) = 0;
+
+        /**
+         * Touching a solid block, see `PlayerPhysics::collideWithBlock`.
+         */
+        virtual void onBlock(Handle block, const CollisionRect& rect) = 0;
+    };
+
+    /**
+     * Objects the player can't collide with (again), or that are tested through `HazardIndex`.
+     */
+    static constexpr uint8_t SKIP_FLAGS =
+        CollisionSection::FlagDisabled | CollisionSection::FlagActivated | CollisionSection::FlagHazard;
+
+    /**
+     * X sections of `HazardIndex`, 100 units wide like `PlayScene::m_sections`.
+     */
+    static int sectionForX(float x) { return static_cast<int>(std::floor(x / 100)); }
+
+    /**
+     * Collides with every object the player overlaps now, then tests the hazards. Returns true if
+     * the player hit a hazard.
+     */
+    bool collideOverlapping(SpatialGrid<Handle>& grid, const HazardIndex& hazards, Host& host);
+
+    /**
+     * Collides with every object on the way from `startRect` to where the player is now, in the
+     * order they were reached, then tests the hazards on the same path. Returns true if the player
+     * hit a hazard.
+     */
+    bool collideSwept(SpatialGrid<Handle>& grid, const HazardIndex& hazards, const CollisionRect& startRect, Host& host);
+
+    /**
+     * What touching `object` does, the game's rules for every object type.
+     */
+    static void collideWithObject(Host& host, Handle object, GameObjectType type, const CollisionRect& rect);
+
+private:
+    struct SweptHit {
+        float toi;
+        CollisionSection* section;
+        size_t index;
+        Handle object;
+    };
+
+    std::vector<uint8_t> m_collisionMask; ///< Scratch space for `rect_overlap::overlap_mask`.
+    std::vector<SweptHit> m_sweptHits;    ///< Scratch space for `collideSwept`.
+};
+
+template <typename Handle>
+bool ObjectCollision<Handle>::collideOverlapping(SpatialGrid<Handle>& grid, const HazardIndex& hazards, Host& host) {
+    CollisionRect playerRect = host.getPlayerRect();
+
+    // Widened by the player's size, resolving a hit can push the player a bit further.
+    float queryMargin = std::max(playerRect.maxX - playerRect.minX, playerRect.maxY - playerRect.minY);
+
+    // The hazards are looked up around where the player was before any object moved it.
+    int section = sectionForX((playerRect.minX + playerRect.maxX) / 2);
+
+    grid.forEachCell(grid.cellsFor(playerRect, queryMargin), [&](auto& cell) {
+        CollisionSection& collision = cell.objects;
+
+        m_collisionMask.resize(collision.size());
+        rect_overlap::overlap_mask(collision, 0, playerRect, m_collisionMask.data());
+
+        for (size_t i = 0; i < collision.size(); i++) {
+            if (!m_collisionMask[i] || (collision.getFlags(i) & SKIP_FLAGS)) {
+                continue;
+            }
+
+            Handle object = cell.handles[i];
+
+            // Activated somewhere else since the flag was last synced, e.g. an orb by `PlayerPhysics::ringJump`.
+            if (host.isObjectActivated(object)) {
+                collision.setActivated(i, true);
+                continue;
+            }
+
+            collideWithObject(host, object, collision.getType(i), collision.getRect(i));
+            collision.setActivated(i, host.isObjectActivated(object));
+
+            // The player may have been pushed out of a block or moved by a portal.
+            CollisionRect movedRect = host.getPlayerRect();
+
+            if (movedRect != playerRect) {
+                playerRect = movedRect;
+                rect_overlap::overlap_mask(collision, i + 1, playerRect, m_collisionMask.data());
+            }
+        }
+    });
+
+    return hazards.intersectsAny(section - 1, section + 1, host.getPlayerRect());
+}
+
+template <typename Handle>
+bool ObjectCollision<Handle>::collideSwept(
+    SpatialGrid<Handle>& grid, const HazardIndex& hazards, const CollisionRect& startRect, Host& host)
+{
+    CollisionRect endRect = host.getPlayerRect();
+    CollisionRect bounds  = rect_overlap::sweep_bounds(startRect, endRect);
+    float dx              = endRect.minX - startRect.minX;
+    float dy              = endRect.minY - startRect.minY;
+
+    m_sweptHits.clear();
+
+    grid.forEachCell(grid.cellsFor(bounds), [&](auto& cell) {
+        m_collisionMask.resize(cell.objects.size());
+        rect_overlap::overlap_mask(cell.objects, 0, bounds, m_collisionMask.data());
+
+        for (size_t i = 0; i < cell.objects.size(); i++) {
+            float toi;
+
+            if (m_collisionMask[i] && !(cell.objects.getFlags(i) & SKIP_FLAGS) &&
+                rect_overlap::sweep_intersects(startRect, dx, dy, cell.objects.getRect(i), toi))
+            {
+                m_sweptHits.push_back({toi, &cell.objects, i, cell.handles[i]});
+            }
+        }
+    });
+
+    // Same order the substeps would have found them in.
+    std::stable_sort(m_sweptHits.begin(), m_sweptHits.end(),
+                     [](const SweptHit& lhs, const SweptHit& rhs) { return lhs.toi < rhs.toi; });
+
+    for (const SweptHit& hit : m_sweptHits) {
+        if (host.isObjectActivated(hit.object)) {
+            hit.section->setActivated(hit.index, true);
+            continue;
+        }
+
+        // An earlier hit may have stopped the player (e.g. landing on a block), only keep what is still on the way.
+        CollisionRect movedRect = host.getPlayerRect();
+
+        if (movedRect != endRect) {
+            endRect = movedRect;
+            dx      = endRect.minX - startRect.minX;
+            dy      = endRect.minY - startRect.minY;
+        }
+
+        float toi;
+        const CollisionRect& rect = hit.section->getRect(hit.index);
+
+        if (!rect_overlap::sweep_intersects(startRect, dx, dy, rect, toi)) {
+            continue;
+        }
+
+        collideWithObject(host, hit.object, hit.section->getType(hit.index), rect);
+        hit.section->setActivated(hit.index, host.isObjectActivated(hit.object));
+    }
+
+    // Hazards are tested against the path up to where the objects left the player.
+    endRect = host.getPlayerRect();
+    bounds  = rect_overlap::sweep_bounds(startRect, endRect);
+    dx      = endRect.minX - startRect.minX;
+    dy      = endRect.minY - startRect.minY;
+
+    return hazards.query(sectionForX(bounds.minX) - 1, sectionForX(bounds.maxX) + 1, bounds,
+        [&](const CollisionRect& hazard) {
+            float toi;
+            return rect_overlap::sweep_intersects(startRect, dx, dy, hazard, toi);
+        });
+}
+
+template <typename Handle>
+void ObjectCollision<Handle>::collideWithObject(Host& host, Handle object, GameObjectType type, const CollisionRect& rect) {
+    switch (type)
+    {
+    case GameObjectType::InvertGravityPortal:
+        host.onGravityPortal(object, true);
+        host.setObjectActivated(object);
+
+        break;
+    case GameObjectType::NormalGravityPortal:
+        host.onGravityPortal(object, false);
+        host.setObjectActivated(object);
+
+        break;
+    case GameObjectType::ShipPortal:
+        host.onShipPortal(object);
+        host.setObjectActivated(object);
+
+        break;
+    case GameObjectType::CubePortal:
+        host.onCubePortal(object);
+        host.setObjectActivated(object);
+
+        break;
+    case GameObjectType::YellowPad:
+        host.setObjectActivated(object);
+        host.onPad(object, 1.0f, host.getGravityFlipped());
+
+        break;
+    case GameObjectType::GravityPad: {
+        bool flipped = (std::fabs(host.getObjectRotation(object)) == 180);
+
+        if (!host.isObjectFlippedY(object)) {
+            flipped ^= true;
+        }
+
+        if (flipped != host.getGravityFlipped()) {
+            host.setObjectActivated(object);
+            host.onPad(object, 0.8f, flipped);
+        }
+
+        break;
+    }
+    case GameObjectType::YellowOrb:
+        [[fallthrough]];
+    case GameObjectType::BlueOrb:
+        host.onOrb(object, type);
+
+        break;
+    case GameObjectType::MirrorPortal:
+        host.onMirrorPortal(object, true);
+        host.setObjectActivated(object);
+
+        break;
+    case GameObjectType::CounterMirrorPortal:
+        host.onMirrorPortal(object, false);
+        host.setObjectActivated(object);
+
+        break;
+    case GameObjectType::BallPortal:
+        host.onBallPortal(object);
+        host.setObjectActivated(object);
+
+        break;
+
+    default:
+        host.onBlock(object, rect);
+        break;
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Plain-data description of a single level object, as stored in the level string.
+ *
+ * This is what the level parser produces before any node is created, so it must stay
+ * cheap to copy and free of engine types.
+ */
+struct ObjectDescriptor {
+    int objectKey = -1; ///< The object or block id.
+
+    float x = 0;
+    float y = 0; ///< Already offset by the ground height (90).
+    float rotation = 0;
+
+    bool flipX = false;
+    bool flipY = false;
+
+    struct {
+        uint8_t r;
+        uint8_t g;
+        uint8_t b;
+    } tint {0, 0, 0};
+
+    float tintDuration = 0;
+};
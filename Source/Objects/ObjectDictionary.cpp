@@ -0,0 +1,24 @@
+#include "ObjectDictionary.h"
+
+#include <nlohmann/json.hpp>
+
+bool parseObjectDictionary(std::string_view json, std::unordered_map<int, std::string>& keyToFrame) {
+    nlohmann::basic_json<> data = nlohmann::json::parse(json);
+
+    if (!data.is_array()) {
+        return false;
+    }
+
+    for (nlohmann::basic_json<>& entry : data) {
+        if (!entry.is_object()) {
+            continue;
+        }
+
+        auto key = entry.value<int>("idx", 0);
+        auto texture = entry.value<std::string>("texture", "");
+
+        keyToFrame[key] = texture;
+    }
+
+    return true;
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/**
+ * Reads `blocks.json`, i.e. which sprite frame every object key uses. Kept free of engine types so
+ * `tombstone-sim` reads the file the same way the game does.
+ *
+ * Returns false if `json` isn't an array of entries, throws like `nlohmann::json::parse` on malformed JSON.
+ */
+bool parseObjectDictionary(std::string_view json, std::unordered_map<int, std::string>& keyToFrame);
@@ -0,0 +1,202 @@
+#include "ObjectTraits.h"
+
+#include <algorithm>
+#include <cstring>
+
+ObjectTraits objectTraitsForKey(int objectKey, std::string_view frame) {
+    ObjectTraits traits;
+
+    auto setParticle = [&traits](const char* plist, int tag) {
+        traits.particle.plist = plist;
+        traits.particle.tag   = tag;
+    };
+
+    auto setParticleColor = [&traits](float r, float g, float b) {
+        traits.particle.hasColor = true;
+        traits.particle.color[0] = r;
+        traits.particle.color[1] = g;
+        traits.particle.color[2] = b;
+        traits.particle.color[3] = 1.0f;
+    };
+
+    switch (objectKey) {
+        case 5:
+        case 73:
+        case 80:
+            traits.type     = GameObjectType::UnknownType;
+            traits.objectZ  = -2;
+            traits.disabled = true;
+            break;
+        case 8:
+            traits.sizeOverride = 30.0f;
+            [[fallthrough]];
+        case 39:
+            traits.type      = GameObjectType::Hazard;
+            traits.scaleModX = 0.2f;
+            traits.scaleModY = 0.4f;
+            break;
+        case 9:
+        case 61:
+            traits.type      = GameObjectType::Hazard;
+            traits.scaleModX = 0.4f;
+            traits.scaleModY = 0.3f;
+            break;
+        case 10:
+            traits.type    = GameObjectType::NormalGravityPortal;
+            traits.objectZ = 10;
+            setParticle("portalEffect01.plist", 3);
+            break;
+        case 11:
+            traits.type    = GameObjectType::InvertGravityPortal;
+            traits.objectZ = 10;
+            setParticle("portalEffect02.plist", 3);
+            break;
+        case 12:
+            traits.type    = GameObjectType::CubePortal;
+            traits.objectZ = 10;
+            setParticle("portalEffect03.plist", 3);
+            break;
+        case 13:
+            traits.type    = GameObjectType::ShipPortal;
+            traits.objectZ = 10;
+            setParticle("portalEffect04.plist", 3);
+            break;
+        case 15:
+        case 16:
+        case 17:
+            traits.type     = GameObjectType::UnknownType;
+            traits.objectZ  = -1;
+            traits.disabled = true;
+            break;
+        case 18:
+        case 19:
+        case 20:
+        case 21:
+            traits.blendAdditive = true;
+            traits.usePCol1      = true;
+            traits.type          = GameObjectType::UnknownType;
+            traits.objectZ       = 0;
+            traits.disabled      = true;
+            break;
+        case 35:
+            traits.type = GameObjectType::YellowPad;
+            setParticle("bumpEffect.plist", 0);
+            break;
+        case 36:
+            traits.type          = GameObjectType::YellowOrb;
+            traits.isOrb         = true;
+            traits.useAudioScale = true;
+            traits.scaleModX     = 1.2f;
+            traits.scaleModY     = 1.2f;
+            setParticle("ringEffect.plist", 3);
+            break;
+        case 37:
+            traits.usePCol1      = true;
+            traits.type          = GameObjectType::UnknownType2;
+            traits.useAudioScale = true;
+            traits.disabled      = true;
+            traits.sizeOverride  = 30.0f;
+            break;
+        case 38:
+            traits.type     = GameObjectType::UnknownType;
+            traits.disabled = true;
+            break;
+        case 41:
+            traits.usePCol1      = true;
+            traits.type          = GameObjectType::UnknownType;
+            traits.blendAdditive = true;
+            traits.disabled      = true;
+            break;
+        case 44:
+            traits.type     = GameObjectType::UnknownType;
+            traits.objectZ  = 2;
+            traits.disabled = true;
+            break;
+        case 45:
+            traits.type    = GameObjectType::MirrorPortal;
+            traits.objectZ = 10;
+            setParticle("portalEffect02.plist", 3);
+            setParticleColor(1.0f, 150.0f / 255, 0.0f);
+            break;
+        case 46:
+            traits.type    = GameObjectType::CounterMirrorPortal;
+            traits.objectZ = 10;
+            setParticle("portalEffect01.plist", 3);
+            break;
+        case 47:
+            traits.type    = GameObjectType::BallPortal;
+            traits.objectZ = 10;
+            setParticle("portalEffect02.plist", 3);
+            setParticleColor(1.0f, 100.0f / 255, 0.0f);
+            break;
+        case 48:
+        case 49:
+            traits.blendAdditive = true;
+            traits.type          = GameObjectType::UnknownType;
+            traits.objectZ       = 0;
+            traits.disabled      = true;
+            traits.usePCol2      = true;
+            break;
+        case 50:
+        case 51:
+        case 52:
+        case 53:
+        case 54:
+        case 60:
+            traits.usePCol1      = true;
+            traits.type          = GameObjectType::UnknownType2;
+            traits.useAudioScale = true;
+            traits.blendAdditive = true;
+            traits.disabled      = true;
+            traits.sizeOverride  = 30.0f;
+            break;
+        case 67:
+            traits.type = GameObjectType::GravityPad;
+            setParticle("bumpEffect.plist", 0);
+            setParticleColor(0.0f, 1.0f, 1.0f);
+            break;
+        case 84:
+            traits.type          = GameObjectType::BlueOrb;
+            traits.isOrb         = true;
+            traits.useAudioScale = true;
+            traits.scaleModX     = 1.2f;
+            traits.scaleModY     = 1.2f;
+            setParticle("ringEffect.plist", 3);
+            setParticleColor(0.0f, 1.0f, 1.0f);
+            break;
+        default:
+            traits.type = GameObjectType::None;
+
+            if (frame.starts_with("edit_e")) {
+                traits.type        = GameObjectType::UnknownType;
+                traits.shouldSpawn = true;
+                traits.disabled    = true;
+                traits.isInvisible = true;
+            }
+    }
+
+    return traits;
+}
+
+const std::vector<const char*>& objectParticlePlists() {
+    // Particles only depend on the key, and the keys of this version stay far below this.
+    constexpr int KEY_LIMIT = 1024;
+
+    static const std::vector<const char*> plists = [] {
+        std::vector<const char*> result;
+
+        for (int key = 0; key < KEY_LIMIT; key++) {
+            const char* plist = objectTraitsForKey(key, {}).particle.plist;
+
+            if (plist && std::none_of(result.begin(), result.end(),
+                                      [plist](const char* other) { return std::strcmp(plist, other) == 0; }))
+            {
+                result.push_back(plist);
+            }
+        }
+
+        return result;
+    }();
+
+    return plists;
+}
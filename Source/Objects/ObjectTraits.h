@@ -0,0 +1,51 @@
+#pragma once
+
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "GameObjectType.h"
+
+/**
+ * Per-key object properties, i.e. everything `GameObject::customSetup` decides from the object key
+ * and frame alone. Kept free of engine types so it can be evaluated without creating the sprite
+ * (lazy sections, hazard index, headless simulation).
+ */
+struct ObjectTraits {
+    struct Particle {
+        const char* plist = nullptr;
+        int tag           = 0;
+        bool hasColor     = false;
+        float color[4]    = {1, 1, 1, 1}; ///< Start and end color, RGBA in 0..1.
+    };
+
+    GameObjectType type = GameObjectType::None;
+
+    std::optional<int> objectZ; ///< Only set for keys that override the default Z.
+
+    /**
+     * Hitbox size for keys that don't use the sprite's content size.
+     */
+    std::optional<float> sizeOverride;
+
+    float scaleModX = 1.0f; ///< Scales the hitbox size
+    float scaleModY = 1.0f;
+
+    bool disabled      = false;
+    bool blendAdditive = false;
+    bool usePCol1      = false;
+    bool usePCol2      = false;
+    bool isOrb         = false;
+    bool useAudioScale = false;
+    bool shouldSpawn   = false;
+    bool isInvisible   = false;
+
+    Particle particle; ///< `particle.plist` is null for keys without a particle.
+};
+
+ObjectTraits objectTraitsForKey(int objectKey, std::string_view frame);
+
+/**
+ * Every distinct `particle.plist` `objectTraitsForKey` hands out, for preloading them all.
+ */
+const std::vector<const char*>& objectParticlePlists();
@@ -0,0 +1,120 @@
+#include "ParticlePool.h"
+#include "Managers/AssetManager.h"
+
+#include <2d/ParticleBatchNode.h>
+#include <2d/ParticleSystemQuad.h>
+
+ParticlePool::Id ParticlePool::intern(int objectType,
+                                      const char* plist,
+                                      int tag,
+                                      ax::ParticleSystem::PositionType positionType)
+{
+    // A level only ever uses a handful of kinds.
+    for (size_t i = 0; i < m_kinds.size(); i++) {
+        const Kind& kind = m_kinds[i];
+
+        if (kind.objectType == objectType && kind.tag == tag && kind.positionType == positionType &&
+            kind.plist == plist)
+        {
+            return static_cast<Id>(i);
+        }
+    }
+
+    m_kinds.push_back({objectType, plist, tag, positionType, {}, {}, {}});
+    return static_cast<Id>(m_kinds.size() - 1);
+}
+
+ax::ParticleSystemQuad* ParticlePool::create(Id id, ax::Node* layer) {
+    constexpr size_t MAX_UNCLAIMED_PER_KIND = 0x13;
+
+    Kind* kind = find(id);
+
+    if (!kind || kind->unclaimedBatched.size() + kind->unclaimedOwn.size() > MAX_UNCLAIMED_PER_KIND) {
+        return nullptr;
+    }
+
+    auto particle = AssetManager::getInstance()->createParticle(kind->plist);
+
+    if (!particle) {
+        return nullptr;
+    }
+
+    m_layer = layer;
+
+    particle->setTag(kind->tag);
+    particle->setPositionType(kind->positionType);
+    particle->stopSystem();
+
+    kind->systems.pushBack(particle);
+    kind->unclaimedBatched.push_back(particle);
+    batchFor(particle, kind->tag)->addChild(particle, kind->tag);
+
+    return particle;
+}
+
+ax::ParticleSystemQuad* ParticlePool::claim(Id id, bool transformed) {
+    Kind* kind = find(id);
+
+    if (!kind) {
+        return nullptr;
+    }
+
+    // Untransformed claims keep the systems that can't go back into a batch in use first.
+    std::vector<ax::ParticleSystemQuad*>& first  = transformed ? kind->unclaimedOwn : kind->unclaimedBatched;
+    std::vector<ax::ParticleSystemQuad*>& second = transformed ? kind->unclaimedBatched : kind->unclaimedOwn;
+    std::vector<ax::ParticleSystemQuad*>& from   = !first.empty() ? first : second;
+
+    if (from.empty()) {
+        return nullptr;
+    }
+
+    ax::ParticleSystemQuad* particle = from.back();
+    from.pop_back();
+
+    if (transformed && particle->getBatchNode()) {
+        // Still referenced by `kind->systems`.
+        particle->removeFromParentAndCleanup(false);
+        m_layer->addChild(particle, kind->tag);
+    }
+
+    particle->setVisible(true);
+
+    return particle;
+}
+
+void ParticlePool::unclaim(Id id, ax::ParticleSystemQuad* particleSystem) {
+    Kind* kind = find(id);
+
+    if (!particleSystem || !kind) {
+        return;
+    }
+
+    if (particleSystem->getBatchNode()) {
+        // The batch draws every quad in its atlas whether the system is visible or not. Stopping
+        // lets the particles that are left run out, off screen since objects only unclaim there.
+        particleSystem->stopSystem();
+        kind->unclaimedBatched.push_back(particleSystem);
+    } else {
+        kind->unclaimedOwn.push_back(particleSystem);
+    }
+
+    particleSystem->setVisible(false);
+}
+
+ax::ParticleBatchNode* ParticlePool::batchFor(ax::ParticleSystemQuad* particle, int z) {
+    ax::Texture2D* texture         = particle->getTexture();
+    const ax::BlendFunc& blendFunc = particle->getBlendFunc();
+
+    for (const Batch& batch : m_batches) {
+        if (batch.texture == texture && batch.blendFunc == blendFunc && batch.z == z) {
+            return batch.node;
+        }
+    }
+
+    ax::ParticleBatchNode* node = ax::ParticleBatchNode::createWithTexture(texture);
+    node->setBlendFunc(blendFunc);
+    m_layer->addChild(node, z);
+
+    m_batches.push_back({texture, blendFunc, z, node});
+    return node;
+}
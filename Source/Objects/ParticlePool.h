@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <2d/ParticleSystem.h>
+#include <base/Vector.h>
+
+namespace ax {
+    class Node;
+    class ParticleBatchNode;
+    class ParticleSystemQuad;
+    class Texture2D;
+}
+
+/**
+ * Particle systems of the objects on screen, shared per kind: object type, plist, tag and
+ * position type. Replaces `PlayScene::m_particleDictionary`, which was keyed by a string formatted
+ * from those on every claim.
+ *
+ * A kind is interned once, when an object is set up (`GameObject::customSetup`). The object keeps
+ * the returned `Id` and claims and unclaims with it, which is a push or pop on the kind's free list.
+ *
+ * Systems are drawn through one `ax::ParticleBatchNode` per texture, blend function and Z, so all
+ * portals, orbs and pads on screen cost a draw call per batch instead of one per system. A batched
+ * system can't be rotated or mirrored, claims that need that get a system of their own, see `claim`.
+ *
+ * Owned by `PlayScene`.
+ */
+class ParticlePool {
+public:
+    using Id                    = int32_t;
+    static constexpr Id INVALID = -1;
+
+    /**
+     * Same id for the same kind. Compares strings, only for setup code.
+     */
+    Id intern(int objectType, const char* plist, int tag, ax::ParticleSystem::PositionType positionType);
+
+    /**
+     * Adds a stopped, unclaimed system of kind `id` to the batch for its texture in `layer`, unless
+     * the kind already has plenty unclaimed. Returns it or null. `layer` has to be the same every time.
+     */
+    ax::ParticleSystemQuad* create(Id id, ax::Node* layer);
+
+    /**
+     * An unclaimed system of kind `id`, now visible, or null if there is none left. With `transformed`
+     * the caller is going to rotate or mirror it, so it is taken out of its batch if it is in one.
+     */
+    ax::ParticleSystemQuad* claim(Id id, bool transformed);
+
+    /**
+     * Hides `particleSystem` and hands it back to kind `id`.
+     */
+    void unclaim(Id id, ax::ParticleSystemQuad* particleSystem);
+
+private:
+    struct Kind {
+        int objectType;
+        std::string plist;
+        int tag;
+        ax::ParticleSystem::PositionType positionType;
+
+        ax::Vector<ax::ParticleSystemQuad*> systems;           ///< Every system of the kind, claimed or not.
+        std::vector<ax::ParticleSystemQuad*> unclaimedBatched;
+        std::vector<ax::ParticleSystemQuad*> unclaimedOwn;     ///< Out of their batch for good, see `claim`.
+    };
+
+    struct Batch {
+        ax::Texture2D* texture;
+        ax::BlendFunc blendFunc;
+        int z;
+        ax::ParticleBatchNode* node; ///< Child of `m_layer`.
+    };
+
+    Kind* find(Id id) { return (id >= 0 && static_cast<size_t>(id) < m_kinds.size()) ? &m_kinds[id] : nullptr; }
+
+    ax::ParticleBatchNode* batchFor(ax::ParticleSystemQuad* particle, int z);
+
+private:
+    std::vector<Kind> m_kinds;
+    std::vector<Batch> m_batches;
+    ax::Node* m_layer = nullptr;
+};
@@ -17,372 +17,71 @@ PlayerObject* PlayerObject::create(int iconID) {
 }
 
 void PlayerObject::update(float dt) {
-    if (m_dead) {
+    if (m_physics.getIsDead()) {
         return;
     }
 
     m_previousPosition = getPosition();
 
-    if (!m_locked) {
-        float moddedDt = dt * 0.9f;
-        updateJump(moddedDt);
-        
-        setPosition({
-            (float)(getPositionX() + (m_velocity.x * moddedDt)),
-            (float)(getPositionY() + (m_velocity.y * moddedDt))
-        });
-    }
-}
-
-void PlayerObject::updateJump(float dt)
-{
-    double var_38;
-    double var_28;
-    double var_30;
-
-    if (m_flyMode)
-    {
-        // loc_14C620
-
-        if (!m_buttonPushed)
-        {
-            // loc_14C6C8
-            if (playerIsFalling() == false)
-            {
-                // loc_14C6D2
-                var_38 = 1.2000000476837158;
-            }
-            else
-            {
-                // loc_14C822
-                var_38 = 0.800000011920929;
-            }
-        }
-        else
-        {
-            var_38 = -1.0;
-        }
-
-        if (m_buttonPushed != false && this->playerIsFalling() != false)
-        {
-            var_28 = 0.5;
-        }
-        else
-        {
-            // loc_14C634
-            var_28 = 0.4000000059604645;
-        }
-
-        // loc_14C63C
-        var_30         = this->m_velocity.y;
-        double tmp     = static_cast<double>(dt) * this->m_gravity;
-        double newYVel = var_30 - tmp * static_cast<double>(this->flipMod()) * var_38 * var_28;
-
-        this->m_velocity.y = newYVel;
-
-        // new
-
-        if (m_gravityFlipped)
-        {
-            // loc_14C6FA
-            if ((newYVel < -8.0) == false)  // note: check if -8.0 is correct
-            {
-                // loc_14C708
-                if (newYVel > 6.400000095367432)
-                    newYVel = 6.400000095367432;
-            }
-            else
-            {
-                // loc_14C806
-                this->m_velocity.y = -8.0;
-                newYVel           = this->m_velocity.y;
-            }
-        }
-        else
-        {
-            if ((newYVel < -6.400000095367432) == false)
-            {
-                // loc_14C6B2
-                if (newYVel > 8.0)
-                    newYVel = 8.0;
-            }
-            else
-            {
-                // loc_14C814
-                this->m_velocity.y = -6.400000095367432;
-                newYVel           = this->m_velocity.y;
-            }
-        }
-
-        // loc_14C71C
-        m_velocity.y = newYVel;
-
-        if (m_buttonPushed)
-            m_onGround = false;
-
-        return;
-    }
-
-    float f_v9;
-
-    if (m_rollMode)
-        f_v9 = 0.6;
-    else
-        f_v9 = 1.0;
-
-    if (m_buttonPushed && m_canJump)
-    {
-        // loc_14C8B2
-        m_onAir = true;
-        m_onGround = false;
-        m_canJump  = false;
-        m_inputBuffered = false;
-
-        this->m_velocity.y = m_jumpYStart * this->flipMod();
-        m_unk20     = true;
-        //this->m_unk26     = sub_14AE00();
-
-        //if (m_bGotGameLayerFromGM_unk)
-        {
-            // INCOMPLETE. TODO: increment jumps
-            //unk = true;
-        }
-
-        if (!m_rollMode)
-            return runRotateAction();
-
-        this->flipGravity(!this->m_gravityFlipped);
-        this->m_velocity.y *= 0.6000000238418579;
-
-        m_unk27             = false;
-        this->m_buttonPushed = false;
-
-        return;
-    }
-
-    if (m_onAir)
-    {
-        // loc_14C594
-        this->m_velocity.y = m_velocity.y - (dt * m_gravity) * static_cast<double>(this->flipMod()) * f_v9;
-
-        if (this->playerIsFalling())
-        {
-            m_onAir = false;
-            m_unk19         = true;
-            m_onGround = false;
-        }
-
-        return;
-    }
-    else
-    {
-        if (this->playerIsFalling())
-            this->m_canJump = false;
-
-        double new_y_velocity =
-            this->m_velocity.y - (dt * m_gravity) * static_cast<double>(this->flipMod()) * f_v9;
-        this->m_velocity.y = new_y_velocity;
-
-        if (this->m_gravityFlipped && new_y_velocity > 15.0)
-            new_y_velocity = 15.0;
-        else if (new_y_velocity < -15.0)
-            new_y_velocity = -15.0;
-
-        this->m_velocity.y = new_y_velocity;
-
-        if (this->playerIsFalling())
-        {
-            if (!this->m_rollMode && !this->getActionByTag(0))
-                this->runRotateAction();
-
-            bool on_ground = false;
-
-            if (this->m_gravityFlipped)
-            {
-                on_ground = this->m_velocity.y > 4.0;
-            }
-            else
-            {
-                on_ground = this->m_velocity.y < -4.0;
-            }
-
-            if (on_ground)
-                this->m_onGround = false;
-        }
-
-        return;
+    if (!m_physics.getIsLocked()) {
+        ax::Vec2 position = getPosition();
+        m_physics.update(dt, position.x, position.y);
+        setPosition(position);
     }
 }
 
 void PlayerObject::hitGround(bool hitGround)
 {
-    //TODO: hitGround
-    m_velocity.y = 0;
-    m_onGround = true;
-    m_canJump  = true;
-    m_unk27           = true;
-
-    m_lastGroundPos = this->getPosition();
-
-    if (!m_rollMode && getActionByTag(0))
-        stopRotation();
-    else if (m_rollMode && !getActionByTag(0))
-        runRotateAction();
-
-    m_unk20 = false;
+    m_physics.hitGround();
 }
 
 void PlayerObject::pushButton(PlayerButton btn)
 {
-    if (PlayerButton::Unk == btn && !m_locked)
+    if (PlayerButton::Unk == btn)
     {
-        m_buttonPushed = true;
-        m_inputBuffered = true;
-
-        if (m_rollMode)
-        {
-            if (m_touchedRing)
-                return ringJump();
-        }
-        else
-        {
-            if (m_touchedRing)
-                return ringJump();
-
-            if (m_flyMode)
-                return;
-        }
-        
-
-        if (m_canJump)
-            updateJump(0);
+        m_physics.pushButton();
     }
 }
 
 void PlayerObject::releaseButton(PlayerButton btn)
 {
-    if (btn == PlayerButton::Unk && m_buttonPushed)
+    if (btn == PlayerButton::Unk)
     {
-        m_buttonPushed = false;
-        m_inputBuffered = false;
+        m_physics.releaseButton();
     }
 }
 
-void PlayerObject::collidedWithObject(float dt, GameObject* object)
+void PlayerObject::collidedWithObject(GameObject* object)
 {
     ax::Rect playerRect   = getObjectRect();
     ax::Rect collidedRect = object->getObjectRect();
 
-    double margin = (!m_flyMode) ? static_cast<float>(flipMod()) * 10.0f : static_cast<float>(flipMod()) * 6.0f;
-
-    float currentYPos  = this->getPositionY();
-    float previousYPos = m_previousPosition.y;
-
-    double point1     = (currentYPos + ((playerRect.size.height * -0.5) * (float)flipMod())) + margin;
-    double point1Prev = (previousYPos + ((playerRect.size.height * -0.5) * (float)flipMod())) + margin;
-    double point2     = (currentYPos + ((playerRect.size.height * -0.5) * (float)-flipMod())) - margin;
-    double point2Prev = (previousYPos + ((playerRect.size.height * -0.5) * (float)-flipMod())) - margin;
-
-    float maxY = collidedRect.getMaxY();
-    float minY = collidedRect.getMinY();
+    // The hitbox swaps sides while the cube is turned by exactly 90 degrees.
+    m_physics.setSize(playerRect.size.width, playerRect.size.height);
 
-    if (m_gravityFlipped && !m_flyMode)
-    {
-        if (point1 <= minY || point1Prev <= minY)
-        {
-            if (m_velocity.y > 0)
-            {
-                setPositionY((playerRect.size.height * -0.5) + minY);
-                // TODO: PlayerObject::checkSnapJumpToObject(this, a3);
-                hitGround((!m_gravityFlipped) ? m_flyMode : false);
-                // TODO: PlayerObject::touchedObject(this, a3);
-            }
-
-            return;
-        }
+    CollisionRect block = {collidedRect.getMinX(), collidedRect.getMinY(), collidedRect.getMaxX(), collidedRect.getMaxY()};
+    float snappedY      = 0;
 
-        goto check_intersection;
-    }
-
-    {
-        double comparePoint1 = (m_gravityFlipped) ? point2 : point1;
-        double comparePoint2 = (m_gravityFlipped) ? point2Prev : point1Prev;
-
-        if (comparePoint1 >= maxY || comparePoint2 >= maxY)
-        {
-            if (m_velocity.y < 0.0)
-            {
-                setPositionY((playerRect.size.height * 0.5) + maxY);
-                // PlayerObject::checkSnapJumpToObject(this, a3);
-                this->hitGround((m_gravityFlipped) ? m_flyMode : false);
-                // PlayerObject::touchedObject(this, a3);
-
-                return;
-            }
-        }
-    }
-
-    if (!m_gravityFlipped && !m_flyMode)
-        goto check_intersection;
-
-    if (!m_gravityFlipped)
-    {
-        point1Prev = point2Prev;
-        point1     = point2;
-    }
-
-    if (point1 <= minY || point1Prev <= minY)
-    {
-        if (m_velocity.y > 0)
-        {
-            setPositionY((playerRect.size.height * -0.5) + minY);
-            // TODO: PlayerObject::checkSnapJumpToObject(this, a3);
-            hitGround((!m_gravityFlipped) ? m_flyMode : false);
-            // TODO: PlayerObject::touchedObject(this, a3);
-        }
-
-        return;
-    }
-    
-check_intersection:
-    if (getObjectRect({0.3, 0.3}).intersectsRect(collidedRect)) {
+    switch (m_physics.collideWithBlock(getPositionX(), getPositionY(), m_previousPosition.y, block, snappedY)) {
+    case PlayerPhysics::BlockContact::Landed:
+        setPositionY(snappedY);
+        hitGround(false);
+        break;
+    case PlayerPhysics::BlockContact::Crushed:
         State::getInstance()->getPlayLayer()->destroyPlayer();
-    };
-
-    return;
-}
-
-void PlayerObject::flipGravity(bool flip) {
-    if (m_gravityFlipped == flip) {
-        return;
-    }
-
-    m_gravityFlipped = flip;
-    m_velocity.y *= 0.5;
-    m_canJump = false;
-
-    setScaleY((!m_flyMode) ? 1 : (m_gravityFlipped) ? -1 : 1);
-
-    if (m_rollMode) {
-        stopRotation();
-        runBallRotation2();
+        break;
+    case PlayerPhysics::BlockContact::None:
+        break;
     }
 }
 
 void PlayerObject::toggleFlyMode(bool toggle) {
-    if (m_flyMode == toggle) {
+    if (!m_physics.toggleFlyMode(toggle)) {
         return;
     }
-    
-    m_flyMode = toggle;
 
     stopRotation();
-
-    m_velocity.y *= 0.5;
     setRotation(0);
-    m_onGround = false;
-    m_canJump  = false;
-    m_unk20    = false;
 
     if (toggle)
     {
@@ -391,7 +90,7 @@ void PlayerObject::toggleFlyMode(bool toggle) {
         m_cubeParts[0]->setScale(0.55);
         m_cubeParts[0]->setPositionY(5);
 
-        if (m_gravityFlipped)
+        if (getGravityFlipped())
             return this->setScaleY(-1);
     }
     else
@@ -404,75 +103,16 @@ void PlayerObject::toggleFlyMode(bool toggle) {
     }
 }
 
-void PlayerObject::propellPlayer(float force)
-{
-    m_onAir = true;
-    m_onGround = false;
-    m_canJump  = false;
-    m_unk20      = true;
-
-    m_velocity.y = (force * 16) * flipMod();
-
-    if (this->m_rollMode)
-        this->m_velocity.y = m_velocity.y * 0.600000024;
-
-    runRotateAction();
-}
-
-void PlayerObject::ringJump()
-{
-    //AXLOGD("inputBuffered {}", _inputBuffered);
-
-    if (m_touchedRing && m_inputBuffered && m_buttonPushed)
-    {
-        m_onAir         = true;
-        m_onGround      = false;
-        m_canJump       = false;
-        m_inputBuffered = false;
-
-        double jump_y = this->m_jumpYStart;
-
-        if (this->m_touchedRing->getType() == GameObjectType::BlueOrb)
-            jump_y *= 0.8;
-
-        this->m_velocity.y = static_cast<double>(this->flipMod()) * jump_y;
-
-        if (this->m_rollMode)
-            this->runBallRotation2();
-        else
-            this->runRotateAction();
-
-        m_lastPortalPos = m_touchedRing->getPosition(); // ???
-
-        // INCOMPLETE. TODO: ORB CIRCLE EFFECT
-
-        m_lastGroundPos = this->getPosition();
-        //this->activateStreak();
-        m_hasRingJumped = true;
-
-        if (this->m_rollMode)
-        {
-            this->m_velocity.y *= 0.699999988079071;
-        }
-
-        if (this->m_touchedRing->getType() == GameObjectType::BlueOrb)
-        {
-            this->flipGravity(!this->m_gravityFlipped);
-            //GameManager::sharedState()->getPlayLayer()->playGravityEffect(this->m_gravityFlipped);
-        }
-
-        m_touchedRing->triggerActivated();
-        //this->m_touchedRing_454->powerOffObject();
-        this->m_touchedRing = NULL;
-    }
+void PlayerObject::setTouchedRing(GameObject* obj) {
+    m_touchedRing = obj;
+    m_physics.setTouchedRing((obj) ? obj->getType() : GameObjectType::None);
 }
 
 void PlayerObject::toggleRollMode(bool toggle)
 {
-    if (m_rollMode == toggle)
+    if (!m_physics.toggleRollMode(toggle))
         return;
 
-    m_rollMode = toggle;
     toggleFlyMode(false);
 
     if (toggle)
@@ -608,14 +248,19 @@ void PlayerObject::setSecondColor(const ax::Color3B& color)
 
 void PlayerObject::playerDestroyed()
 {
-    m_dead = true;
+    m_physics.setIsDead(true);
     stopRotation();
 
     auto fade = ax::FadeTo::create(0.05, 0);
     fade->setTag(3);
     runAction(fade);
 
-    auto particle = ax::ParticleSystemQuad::create("explodeEffect.plist");
+    auto particle = AssetManager::getInstance()->createParticle("explodeEffect.plist");
+
+    if (!particle) {
+        return;
+    }
+
     particle->setPosition(getPosition());
     particle->setPositionType(ax::ParticleSystem::PositionType::GROUPED);
     particle->setAutoRemoveOnFinish(true);
@@ -637,20 +282,17 @@ void PlayerObject::resetObject()
     //TODO: this
     m_unk18 = true;
     m_portalObject = nullptr;
-    m_locked       = false;
-    m_unk20        = false;
+    m_physics.reset();
 
 
     setPosition(State::getInstance()->getPlayLayer()->getStartPos());
     
     
-    m_velocity.y = 0;
     flipGravity(false);
     toggleFlyMode(false);
     toggleRollMode(false);
     stopRotation();
     setRotation(0);
-    m_dead  = false;
     stopActionByTag(3);
     setOpacity(255);
 
@@ -685,9 +327,9 @@ bool PlayerObject::init(int iconID)
     this->addChild(m_ship, 2);
     m_ship->setVisible(false);
 
-    m_velocity = {5.7700018882751465, 0};
-    m_jumpYStart = 11.180031776428223;  // 0x40265C2D20000000
-    m_gravity    = 0.9581990242004395;  // 0x3FEEA99100000000LL
+    ax::Rect hitbox = getObjectRect();
+    m_physics.setSize(hitbox.size.width, hitbox.size.height);
+    m_physics.setListener(this);
 
     AssetManager* assetManager = AssetManager::getInstance();
 
@@ -704,44 +346,25 @@ bool PlayerObject::init(int iconID)
     return true;
 }
 
-bool PlayerObject::playerIsFalling()
-{
-    //TODO: Check if this is actually correct
-
-    if (m_gravityFlipped)
-    {
-        return (m_velocity.y > (m_gravity + m_gravity));
-    }
-    else
-    {
-        return (m_velocity.y < (m_gravity + m_gravity));
-    }
-}
-
-int PlayerObject::flipMod()
-{
-    return (m_gravityFlipped) ? -1 : 1;
-}
-
 void PlayerObject::stopRotation()
 {
     this->stopActionByTag(0);
     this->stopActionByTag(1);
 
-    if (getRotation() != 0 && !m_rollMode)
+    if (getRotation() != 0 && !getRollMode())
     {
         int modRot = (int)getRotation() % 360;
-        float newRot = (flipMod() == 1) ? 90 * roundf((float)modRot / 90.0f) : -90 * roundf((float)modRot / -90.0f);
+        float newRot = (m_physics.flipMod() == 1) ? 90 * roundf((float)modRot / 90.0f) : -90 * roundf((float)modRot / -90.0f);
         this->setRotation(newRot);
     }
 }
 
 void PlayerObject::runRotateAction()
 {
-    if (!m_locked)
+    if (!getIsLocked())
     {
         stopRotation();
-        if (m_rollMode)
+        if (getRollMode())
         {
             runBallRotation();
         }
@@ -754,9 +377,9 @@ void PlayerObject::runRotateAction()
 
 void PlayerObject::runNormalRotation()
 {
-    if (!m_flyMode)
+    if (!getFlyMode())
     {
-        auto rotAct = ax::RotateBy::create(0.43333f, 180 * flipMod());
+        auto rotAct = ax::RotateBy::create(0.43333f, 180 * m_physics.flipMod());
         rotAct->setTag(0);
         this->runAction(rotAct);
     }
@@ -764,14 +387,66 @@ void PlayerObject::runNormalRotation()
 
 void PlayerObject::runBallRotation()
 {
-    auto act = ax::RepeatForever::create(ax::RotateBy::create(0.2, 120 * flipMod()));
+    auto act = ax::RepeatForever::create(ax::RotateBy::create(0.2, 120 * m_physics.flipMod()));
     act->setTag(0);
     this->runAction(act);
 }
 
 void PlayerObject::runBallRotation2()
 {
-    auto act = ax::EaseOut::create(ax::RotateBy::create(0.4, -200 * flipMod()), 1.6);
+    auto act = ax::EaseOut::create(ax::RotateBy::create(0.4, -200 * m_physics.flipMod()), 1.6);
     act->setTag(1);
     runAction(act);
 }
+
+void PlayerObject::onJump()
+{
+    if (!getRollMode())
+        runRotateAction();
+}
+
+void PlayerObject::onFalling()
+{
+    if (!getRollMode() && !getActionByTag(0))
+        runRotateAction();
+}
+
+void PlayerObject::onHitGround()
+{
+    m_lastGroundPos = this->getPosition();
+
+    if (!getRollMode() && getActionByTag(0))
+        stopRotation();
+    else if (getRollMode() && !getActionByTag(0))
+        runRotateAction();
+}
+
+void PlayerObject::onGravityFlipped()
+{
+    setScaleY((!getFlyMode()) ? 1 : (getGravityFlipped()) ? -1 : 1);
+
+    if (getRollMode()) {
+        stopRotation();
+        runBallRotation2();
+    }
+}
+
+void PlayerObject::onPropelled()
+{
+    runRotateAction();
+}
+
+void PlayerObject::onRingJump()
+{
+    if (getRollMode())
+        this->runBallRotation2();
+    else
+        this->runRotateAction();
+
+    m_lastPortalPos = m_touchedRing->getPosition(); // ???
+    m_lastGroundPos = this->getPosition();
+    //this->activateStreak();
+
+    m_touchedRing->triggerActivated();
+    this->m_touchedRing = NULL;
+}
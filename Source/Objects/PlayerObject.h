@@ -1,6 +1,7 @@
 #pragma once
 
 #include "GameObject.h"
+#include "PlayerPhysics.h"
 
 namespace ax {
     class Sprite;
@@ -15,29 +16,31 @@ enum class PlayerButton : uint8_t {
     Unk = 1
 };
 
-class PlayerObject : public GameObject {
+class PlayerObject : public GameObject, private PlayerPhysics::Listener {
 public:
     static PlayerObject* create(int iconID);
     void update(float dt) override;
-    void updateJump(float dt);
-    bool getIsLocked() const { return m_locked; }
+    void updateJump(float dt) { m_physics.updateJump(dt); }
+    bool getIsLocked() const { return m_physics.getIsLocked(); }
     void hitGround(bool hitGround);
-    bool getFlyMode() const { return m_flyMode; }
-    bool getRollMode() const { return m_rollMode; }
-    bool getGravityFlipped() const { return m_gravityFlipped; }
+    bool getFlyMode() const { return m_physics.getFlyMode(); }
+    bool getRollMode() const { return m_physics.getRollMode(); }
+    bool getGravityFlipped() const { return m_physics.getGravityFlipped(); }
     void pushButton(PlayerButton);
     void releaseButton(PlayerButton);
-    void collidedWithObject(float, GameObject*);
+    void collidedWithObject(GameObject*);
     ax::Vec2 getRealPosition() const override { return this->getPosition(); }
-    void flipGravity(bool);
+    void flipGravity(bool flip) { m_physics.flipGravity(flip); }
     void setPortalP(ax::Vec2 p) { m_lastPortalPos = p; }
     void setPortalObject(GameObject* o) { m_portalObject = o; }
     void toggleFlyMode(bool toggle);
-    void propellPlayer(float);
-    void setTouchedRing(GameObject* obj) { m_touchedRing = obj; }
-    void ringJump();
+    void propellPlayer(float force) { m_physics.propellPlayer(force); }
+    void setTouchedRing(GameObject* obj);
+    void ringJump() { m_physics.ringJump(); }
     void toggleRollMode(bool toggle);
     ax::Vec2 getLastGroundPos() const { return m_lastGroundPos; }
+    ax::Vec2 getPreviousPosition() const { return m_previousPosition; } ///< Position before the last `update`.
+    const PlayerPhysics& getPhysics() const { return m_physics; }
     void updatePlayerFrame(int);
     void updateShipRotation(float);
     void setPosition(const ax::Vec2&) override;
@@ -48,47 +51,30 @@ public:
     void resetObject() override;
 private:
     bool init(int iconID);
-    bool playerIsFalling();
-    int flipMod();
     void stopRotation();
     void runRotateAction();
     void runNormalRotation();
     void runBallRotation();
     void runBallRotation2();
+
+    void onJump() override;
+    void onFalling() override;
+    void onHitGround() override;
+    void onGravityFlipped() override;
+    void onPropelled() override;
+    void onRingJump() override;
 private:
-    bool m_buttonPushed;
-    bool m_onAir; ///< Offset (1.3): 0x365
-    bool m_onGround;
-    bool m_gravityFlipped;
-    bool m_dead;
-    bool m_locked;
-    bool m_canJump;
-    bool m_inputBuffered;
-    bool m_hasRingJumped;
+    PlayerPhysics m_physics;
 
     GameObject* m_touchedRing;
     GameObject* m_portalObject;
     ax::Vec2 m_lastPortalPos;
     ax::Vec2 m_lastGroundPos;
-
-    bool m_flyMode;
-    bool m_rollMode;
-
-    double m_gravity;
-    double m_jumpYStart;
-
-    struct {
-        double x;
-        double y;
-    } m_velocity;
     ax::Vec2 m_previousPosition;
 
     ax::Sprite* m_cubeParts[2];
     ax::Sprite* m_ship;
 
-    bool m_unk27;
-    bool m_unk19;
-    bool m_unk20;
     bool m_unk18;
 
     ax::MotionStreak* m_motionStreak;
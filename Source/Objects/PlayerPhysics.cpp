@@ -0,0 +1,454 @@
+#include "PlayerPhysics.h"
+
+void PlayerPhysics::setSize(float width, float height) {
+    m_width  = width;
+    m_height = height;
+}
+
+CollisionRect PlayerPhysics::rectAt(float x, float y, float scale) const {
+    float halfWidth  = m_width * scale * 0.5f;
+    float halfHeight = m_height * scale * 0.5f;
+
+    return {x - halfWidth, y - halfHeight, x + halfWidth, y + halfHeight};
+}
+
+void PlayerPhysics::reset() {
+    m_locked     = false;
+    m_unk20      = false;
+    m_velocity.y = 0;
+    m_dead       = false;
+}
+
+void PlayerPhysics::update(float dt, float& x, float& y) {
+    if (m_dead || m_locked) {
+        return;
+    }
+
+    float moddedDt = dt * 0.9f;
+    updateJump(moddedDt);
+
+    x = (float)(x + (m_velocity.x * moddedDt));
+    y = (float)(y + (m_velocity.y * moddedDt));
+}
+
+void PlayerPhysics::updateJump(float dt)
+{
+    double var_38;
+    double var_28;
+    double var_30;
+
+    if (m_flyMode)
+    {
+        // loc_14C620
+
+        if (!m_buttonPushed)
+        {
+            // loc_14C6C8
+            if (playerIsFalling() == false)
+            {
+                // loc_14C6D2
+                var_38 = 1.2000000476837158;
+            }
+            else
+            {
+                // loc_14C822
+                var_38 = 0.800000011920929;
+            }
+        }
+        else
+        {
+            var_38 = -1.0;
+        }
+
+        if (m_buttonPushed != false && this->playerIsFalling() != false)
+        {
+            var_28 = 0.5;
+        }
+        else
+        {
+            // loc_14C634
+            var_28 = 0.4000000059604645;
+        }
+
+        // loc_14C63C
+        var_30         = this->m_velocity.y;
+        double tmp     = static_cast<double>(dt) * this->m_gravity;
+        double newYVel = var_30 - tmp * static_cast<double>(this->flipMod()) * var_38 * var_28;
+
+        this->m_velocity.y = newYVel;
+
+        // new
+
+        if (m_gravityFlipped)
+        {
+            // loc_14C6FA
+            if ((newYVel < -8.0) == false)  // note: check if -8.0 is correct
+            {
+                // loc_14C708
+                if (newYVel > 6.400000095367432)
+                    newYVel = 6.400000095367432;
+            }
+            else
+            {
+                // loc_14C806
+                this->m_velocity.y = -8.0;
+                newYVel           = this->m_velocity.y;
+            }
+        }
+        else
+        {
+            if ((newYVel < -6.400000095367432) == false)
+            {
+                // loc_14C6B2
+                if (newYVel > 8.0)
+                    newYVel = 8.0;
+            }
+            else
+            {
+                // loc_14C814
+                this->m_velocity.y = -6.400000095367432;
+                newYVel           = this->m_velocity.y;
+            }
+        }
+
+        // loc_14C71C
+        m_velocity.y = newYVel;
+
+        if (m_buttonPushed)
+            m_onGround = false;
+
+        return;
+    }
+
+    float f_v9;
+
+    if (m_rollMode)
+        f_v9 = 0.6;
+    else
+        f_v9 = 1.0;
+
+    if (m_buttonPushed && m_canJump)
+    {
+        // loc_14C8B2
+        m_onAir = true;
+        m_onGround = false;
+        m_canJump  = false;
+        m_inputBuffered = false;
+
+        this->m_velocity.y = m_jumpYStart * this->flipMod();
+        m_unk20     = true;
+        //this->m_unk26     = sub_14AE00();
+
+        //if (m_bGotGameLayerFromGM_unk)
+        {
+            // INCOMPLETE. TODO: increment jumps
+            //unk = true;
+        }
+
+        if (m_listener)
+            m_listener->onJump();
+
+        if (!m_rollMode)
+            return;
+
+        this->flipGravity(!this->m_gravityFlipped);
+        this->m_velocity.y *= 0.6000000238418579;
+
+        m_unk27             = false;
+        this->m_buttonPushed = false;
+
+        return;
+    }
+
+    if (m_onAir)
+    {
+        // loc_14C594
+        this->m_velocity.y = m_velocity.y - (dt * m_gravity) * static_cast<double>(this->flipMod()) * f_v9;
+
+        if (this->playerIsFalling())
+        {
+            m_onAir = false;
+            m_unk19         = true;
+            m_onGround = false;
+        }
+
+        return;
+    }
+    else
+    {
+        if (this->playerIsFalling())
+            this->m_canJump = false;
+
+        double new_y_velocity =
+            this->m_velocity.y - (dt * m_gravity) * static_cast<double>(this->flipMod()) * f_v9;
+        this->m_velocity.y = new_y_velocity;
+
+        if (this->m_gravityFlipped && new_y_velocity > 15.0)
+            new_y_velocity = 15.0;
+        else if (new_y_velocity < -15.0)
+            new_y_velocity = -15.0;
+
+        this->m_velocity.y = new_y_velocity;
+
+        if (this->playerIsFalling())
+        {
+            if (m_listener)
+                m_listener->onFalling();
+
+            bool on_ground = false;
+
+            if (this->m_gravityFlipped)
+            {
+                on_ground = this->m_velocity.y > 4.0;
+            }
+            else
+            {
+                on_ground = this->m_velocity.y < -4.0;
+            }
+
+            if (on_ground)
+                this->m_onGround = false;
+        }
+
+        return;
+    }
+}
+
+void PlayerPhysics::hitGround()
+{
+    //TODO: hitGround
+    m_velocity.y = 0;
+    m_onGround = true;
+    m_canJump  = true;
+    m_unk27           = true;
+
+    if (m_listener)
+        m_listener->onHitGround();
+
+    m_unk20 = false;
+}
+
+void PlayerPhysics::pushButton()
+{
+    if (m_locked)
+        return;
+
+    m_buttonPushed = true;
+    m_inputBuffered = true;
+
+    if (m_touchedRing != GameObjectType::None)
+    {
+        ringJump();
+        return;
+    }
+
+    if (!m_rollMode && m_flyMode)
+        return;
+
+    if (m_canJump)
+        updateJump(0);
+}
+
+void PlayerPhysics::releaseButton()
+{
+    if (m_buttonPushed)
+    {
+        m_buttonPushed = false;
+        m_inputBuffered = false;
+    }
+}
+
+PlayerPhysics::BlockContact PlayerPhysics::collideWithBlock(float x, float y, float previousY,
+                                                            const CollisionRect& block, float& snappedY) const
+{
+    float height = m_height;
+
+    double margin = (!m_flyMode) ? static_cast<float>(flipMod()) * 10.0f : static_cast<float>(flipMod()) * 6.0f;
+
+    float currentYPos  = y;
+    float previousYPos = previousY;
+
+    double point1     = (currentYPos + ((height * -0.5) * (float)flipMod())) + margin;
+    double point1Prev = (previousYPos + ((height * -0.5) * (float)flipMod())) + margin;
+    double point2     = (currentYPos + ((height * -0.5) * (float)-flipMod())) - margin;
+    double point2Prev = (previousYPos + ((height * -0.5) * (float)-flipMod())) - margin;
+
+    float maxY = block.maxY;
+    float minY = block.minY;
+
+    if (m_gravityFlipped && !m_flyMode)
+    {
+        if (point1 <= minY || point1Prev <= minY)
+        {
+            if (m_velocity.y > 0)
+            {
+                snappedY = (height * -0.5) + minY;
+                // TODO: PlayerObject::checkSnapJumpToObject(this, a3);
+                // TODO: PlayerObject::touchedObject(this, a3);
+                return BlockContact::Landed;
+            }
+
+            return BlockContact::None;
+        }
+
+        goto check_intersection;
+    }
+
+    {
+        double comparePoint1 = (m_gravityFlipped) ? point2 : point1;
+        double comparePoint2 = (m_gravityFlipped) ? point2Prev : point1Prev;
+
+        if (comparePoint1 >= maxY || comparePoint2 >= maxY)
+        {
+            if (m_velocity.y < 0.0)
+            {
+                snappedY = (height * 0.5) + maxY;
+                // PlayerObject::checkSnapJumpToObject(this, a3);
+                // PlayerObject::touchedObject(this, a3);
+                return BlockContact::Landed;
+            }
+        }
+    }
+
+    if (!m_gravityFlipped && !m_flyMode)
+        goto check_intersection;
+
+    if (!m_gravityFlipped)
+    {
+        point1Prev = point2Prev;
+        point1     = point2;
+    }
+
+    if (point1 <= minY || point1Prev <= minY)
+    {
+        if (m_velocity.y > 0)
+        {
+            snappedY = (height * -0.5) + minY;
+            // TODO: PlayerObject::checkSnapJumpToObject(this, a3);
+            // TODO: PlayerObject::touchedObject(this, a3);
+            return BlockContact::Landed;
+        }
+
+        return BlockContact::None;
+    }
+
+check_intersection:
+    if (rectAt(x, y, 0.3f).intersects(block)) {
+        return BlockContact::Crushed;
+    }
+
+    return BlockContact::None;
+}
+
+bool PlayerPhysics::flipGravity(bool flip) {
+    if (m_gravityFlipped == flip) {
+        return false;
+    }
+
+    m_gravityFlipped = flip;
+    m_velocity.y *= 0.5;
+    m_canJump = false;
+
+    if (m_listener) {
+        m_listener->onGravityFlipped();
+    }
+
+    return true;
+}
+
+bool PlayerPhysics::toggleFlyMode(bool toggle) {
+    if (m_flyMode == toggle) {
+        return false;
+    }
+
+    m_flyMode = toggle;
+
+    m_velocity.y *= 0.5;
+    m_onGround = false;
+    m_canJump  = false;
+    m_unk20    = false;
+
+    return true;
+}
+
+bool PlayerPhysics::toggleRollMode(bool toggle) {
+    if (m_rollMode == toggle) {
+        return false;
+    }
+
+    m_rollMode = toggle;
+    return true;
+}
+
+void PlayerPhysics::propellPlayer(float force)
+{
+    m_onAir = true;
+    m_onGround = false;
+    m_canJump  = false;
+    m_unk20      = true;
+
+    m_velocity.y = (force * 16) * flipMod();
+
+    if (this->m_rollMode)
+        this->m_velocity.y = m_velocity.y * 0.600000024;
+
+    if (m_listener)
+        m_listener->onPropelled();
+}
+
+bool PlayerPhysics::ringJump()
+{
+    //AXLOGD("inputBuffered {}", _inputBuffered);
+
+    if (m_touchedRing == GameObjectType::None || !m_inputBuffered || !m_buttonPushed)
+        return false;
+
+    m_onAir         = true;
+    m_onGround      = false;
+    m_canJump       = false;
+    m_inputBuffered = false;
+
+    double jump_y = this->m_jumpYStart;
+
+    if (m_touchedRing == GameObjectType::BlueOrb)
+        jump_y *= 0.8;
+
+    this->m_velocity.y = static_cast<double>(this->flipMod()) * jump_y;
+
+    // INCOMPLETE. TODO: ORB CIRCLE EFFECT
+
+    if (m_listener)
+        m_listener->onRingJump();
+
+    m_hasRingJumped = true;
+
+    if (this->m_rollMode)
+    {
+        this->m_velocity.y *= 0.699999988079071;
+    }
+
+    if (m_touchedRing == GameObjectType::BlueOrb)
+    {
+        this->flipGravity(!this->m_gravityFlipped);
+        //GameManager::sharedState()->getPlayLayer()->playGravityEffect(this->m_gravityFlipped);
+    }
+
+    //this->m_touchedRing_454->powerOffObject();
+    m_touchedRing = GameObjectType::None;
+
+    return true;
+}
+
+bool PlayerPhysics::playerIsFalling() const
+{
+    //TODO: Check if this is actually correct
+
+    if (m_gravityFlipped)
+    {
+        return (m_velocity.y > (m_gravity + m_gravity));
+    }
+    else
+    {
+        return (m_velocity.y < (m_gravity + m_gravity));
+    }
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "CollisionSection.h"
+#include "GameObjectType.h"
+
+/**
+ * Engine-free half of `PlayerObject`: velocity, gravity, jumps, game modes and how the player lands
+ * on blocks. `PlayerObject` owns one and forwards to it, everything visual (rotation actions, ship
+ * sprite, streak) stays there and is driven through `PlayerPhysics::Listener`.
+ *
+ * The position isn't stored here, the owner passes it in: `PlayerObject` keeps it in the node,
+ * `tombstone-sim` in plain floats.
+ */
+class PlayerPhysics {
+public:
+    /**
+     * Told about state changes that need a visual reaction. All hooks are optional.
+     */
+    class Listener {
+    public:
+        virtual ~Listener() = default;
+
+        virtual void onJump() {}           ///< Jumped off the ground, in any mode but the ship.
+        virtual void onFalling() {}        ///< Started falling while not on an orb/pad arc.
+        virtual void onHitGround() {}      ///< Called after the owner snapped the player onto the ground.
+        virtual void onGravityFlipped() {}
+        virtual void onPropelled() {}      ///< Launched by a pad.
+        virtual void onRingJump() {}       ///< Jumped off the touched orb, which is used up now.
+    };
+
+    enum class BlockContact {
+        None,
+        Landed,  ///< Hit the top (or the bottom, upside down / in the ship) of the block, snap to `snappedY`.
+        Crushed, ///< Ran into the block, the player dies.
+    };
+
+    void setListener(Listener* listener) { m_listener = listener; }
+
+    /**
+     * Hitbox size, the hitbox is centered on the position.
+     */
+    void setSize(float width, float height);
+    float getWidth() const { return m_width; }
+    float getHeight() const { return m_height; }
+
+    CollisionRect rectAt(float x, float y, float scale = 1.0f) const;
+
+    /**
+     * Clears everything `PlayerObject::resetObject` resets except the game mode and gravity, which
+     * go through `toggleFlyMode`/`toggleRollMode`/`flipGravity` so the visuals follow.
+     */
+    void reset();
+
+    /**
+     * Advances the jump and moves `(x, y)` by one step of `dt` (in 60 Hz frames).
+     */
+    void update(float dt, float& x, float& y);
+    void updateJump(float dt);
+
+    /**
+     * The owner has already snapped the player onto the ground.
+     */
+    void hitGround();
+
+    void pushButton();
+    void releaseButton();
+
+    /**
+     * Collision response against a solid block. The player is at `(x, y)` now and was at `previousY`
+     * before the current step.
+     */
+    BlockContact collideWithBlock(float x, float y, float previousY, const CollisionRect& block, float& snappedY) const;
+
+    /**
+     * Returns false if nothing changed.
+     */
+    bool flipGravity(bool flip);
+    bool toggleFlyMode(bool toggle);
+
+    /**
+     * Doesn't leave fly mode by itself, callers do that through `toggleFlyMode(false)` so the ship visuals go away too.
+     */
+    bool toggleRollMode(bool toggle);
+
+    void propellPlayer(float force);
+
+    /**
+     * Orb the player currently overlaps, `GameObjectType::None` if there is none.
+     */
+    void setTouchedRing(GameObjectType type) { m_touchedRing = type; }
+    GameObjectType getTouchedRing() const { return m_touchedRing; }
+
+    /**
+     * Jumps off the touched orb if the button was pressed for it. Returns true if it did.
+     */
+    bool ringJump();
+
+    bool getIsDead() const { return m_dead; }
+    void setIsDead(bool dead) { m_dead = dead; }
+    bool getIsLocked() const { return m_locked; }
+    bool getOnGround() const { return m_onGround; }
+    bool getFlyMode() const { return m_flyMode; }
+    bool getRollMode() const { return m_rollMode; }
+    bool getGravityFlipped() const { return m_gravityFlipped; }
+    bool getButtonPushed() const { return m_buttonPushed; }
+    double getVelocityX() const { return m_velocity.x; }
+    double getVelocityY() const { return m_velocity.y; }
+
+    int flipMod() const { return (m_gravityFlipped) ? -1 : 1; }
+
+private:
+    bool playerIsFalling() const;
+
+private:
+    Listener* m_listener = nullptr;
+
+    bool m_buttonPushed   = false;
+    bool m_onAir          = false; ///< Offset (1.3): 0x365
+    bool m_onGround       = false;
+    bool m_gravityFlipped = false;
+    bool m_dead           = false;
+    bool m_locked         = false;
+    bool m_canJump        = false;
+    bool m_inputBuffered  = false;
+    bool m_hasRingJumped  = false;
+
+    bool m_flyMode  = false;
+    bool m_rollMode = false;
+
+    GameObjectType m_touchedRing = GameObjectType::None;
+
+    double m_gravity    = 0.9581990242004395;  // 0x3FEEA99100000000LL
+    double m_jumpYStart = 11.180031776428223;  // 0x40265C2D20000000
+
+    struct {
+        double x;
+        double y;
+    } m_velocity = {5.7700018882751465, 0};
+
+    float m_width  = 30;
+    float m_height = 30;
+
+    bool m_unk27 = false;
+    bool m_unk19 = false;
+    bool m_unk20 = false;
+};
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "CollisionSection.h"
+
+/**
+ * Uniform 2D grid over game space. Unlike the 100 unit X sections of `PlayScene`, tall columns of
+ * blocks and decoration end up in different cells, so a query only looks at what is near it vertically too.
+ *
+ * Every object is stored once, in the cell that contains the center of its hitbox. Queries are
+ * widened by the largest half extent inserted so far, which keeps them exact without storing an
+ * object in every cell it touches. Coordinates below zero are clamped into the first row/column.
+ *
+ * Each cell keeps its hitboxes as a `CollisionSection`, with `handles[i]` identifying object `i`.
+ */
+template <typename Handle>
+class SpatialGrid {
+public:
+    struct Cell {
+        CollisionSection objects;
+        std::vector<Handle> handles;
+    };
+
+    struct CellRange {
+        int firstColumn = 0;
+        int lastColumn  = -1;
+        int firstRow    = 0;
+        int lastRow     = -1;
+
+        bool empty() const { return lastColumn < firstColumn || lastRow < firstRow; }
+
+        bool contains(int column, int row) const {
+            return column >= firstColumn && column <= lastColumn && row >= firstRow && row <= lastRow;
+        }
+
+        CellRange intersect(const CellRange& other) const {
+            return {std::max(firstColumn, other.firstColumn), std::min(lastColumn, other.lastColumn),
+                    std::max(firstRow, other.firstRow), std::min(lastRow, other.lastRow)};
+        }
+
+        /**
+         * Smallest range covering both.
+         */
+        CellRange merge(const CellRange& other) const {
+            if (empty()) {
+                return other;
+            }
+
+            if (other.empty()) {
+                return *this;
+            }
+
+            return {std::min(firstColumn, other.firstColumn), std::max(lastColumn, other.lastColumn),
+                    std::min(firstRow, other.firstRow), std::max(lastRow, other.lastRow)};
+        }
+    };
+
+    explicit SpatialGrid(float cellWidth = 100, float cellHeight = 100) {
+        setCellSize(cellWidth, cellHeight);
+    }
+
+    /**
+     * Changing the cell size drops everything in the grid.
+     */
+    void setCellSize(float cellWidth, float cellHeight) {
+        clear();
+        m_cellWidth  = std::max(cellWidth, 1.0f);
+        m_cellHeight = std::max(cellHeight, 1.0f);
+    }
+
+    float getCellWidth() const { return m_cellWidth; }
+    float getCellHeight() const { return m_cellHeight; }
+
+    int columnForX(float x) const { return std::max(static_cast<int>(std::floor(x / m_cellWidth)), 0); }
+    int rowForY(float y) const { return std::max(static_cast<int>(std::floor(y / m_cellHeight)), 0); }
+
+    void insert(Handle handle, const CollisionRect& rect, GameObjectType type, uint8_t flags) {
+        int column = columnForX((rect.minX + rect.maxX) / 2);
+        int row    = rowForY((rect.minY + rect.maxY) / 2);
+
+        // Both are clamped to 0 by `columnForX` and `rowForY`.
+        size_t columnIdx = static_cast<size_t>(column);
+        size_t rowIdx    = static_cast<size_t>(row);
+
+        if (m_columns.size() <= columnIdx) {
+            m_columns.resize(columnIdx + 1);
+        }
+
+        std::vector<Cell>& rows = m_columns[columnIdx];
+
+        if (rows.size() <= rowIdx) {
+            rows.resize(rowIdx + 1);
+            m_rowCount = std::max(m_rowCount, rows.size());
+        }
+
+        Cell& cell = rows[rowIdx];
+        cell.objects.add(rect, type, flags);
+        cell.handles.push_back(handle);
+
+        m_maxHalfWidth  = std::max(m_maxHalfWidth, (rect.maxX - rect.minX) / 2);
+        m_maxHalfHeight = std::max(m_maxHalfHeight, (rect.maxY - rect.minY) / 2);
+        m_size++;
+    }
+
+    /**
+     * Removes `handle`, which must have been inserted with the same `rect`.
+     */
+    bool remove(Handle handle, const CollisionRect& rect) {
+        Cell* cell = findCell(columnForX((rect.minX + rect.maxX) / 2), rowForY((rect.minY + rect.maxY) / 2));
+
+        if (!cell) {
+            return false;
+        }
+
+        auto it = std::find(cell->handles.begin(), cell->handles.end(), handle);
+
+        if (it == cell->handles.end()) {
+            return false;
+        }
+
+        size_t idx = std::distance(cell->handles.begin(), it);
+        cell->handles.erase(it);
+        cell->objects.erase(idx);
+        m_size--;
+
+        return true;
+    }
+
+    void clear() {
+        m_columns.clear();
+        m_rowCount      = 0;
+        m_maxHalfWidth  = 0;
+        m_maxHalfHeight = 0;
+        m_size          = 0;
+    }
+
+    size_t size() const { return m_size; }
+
+    /**
+     * Cells that can hold an object whose hitbox intersects `area`, widened by `margin` on every side.
+     */
+    CellRange cellsFor(const CollisionRect& area, float margin = 0) const {
+        margin += 1; // Rounding of the stored centers.
+
+        CellRange range;
+        range.firstColumn = columnForX(area.minX - m_maxHalfWidth - margin);
+        range.lastColumn  = std::min(columnForX(area.maxX + m_maxHalfWidth + margin), static_cast<int>(m_columns.size()) - 1);
+        range.firstRow    = rowForY(area.minY - m_maxHalfHeight - margin);
+        range.lastRow     = std::min(rowForY(area.maxY + m_maxHalfHeight + margin), static_cast<int>(m_rowCount) - 1);
+        return range;
+    }
+
+    /**
+     * Cells whose area intersects `area`, i.e. the cells of every object whose hitbox center is inside it.
+     */
+    CellRange cellsForCenters(const CollisionRect& area) const {
+        CellRange range;
+        range.firstColumn = columnForX(area.minX);
+        range.lastColumn  = std::min(columnForX(area.maxX), static_cast<int>(m_columns.size()) - 1);
+        range.firstRow    = rowForY(area.minY);
+        range.lastRow     = std::min(rowForY(area.maxY), static_cast<int>(m_rowCount) - 1);
+        return range;
+    }
+
+    /**
+     * Calls `callback(Cell&)` for every non-empty cell of `range`, column by column and bottom to top.
+     */
+    template <typename Callback>
+    void forEachCell(const CellRange& range, Callback&& callback) {
+        for (int column = range.firstColumn; column <= range.lastColumn; column++) {
+            std::vector<Cell>& rows = m_columns[column];
+            int lastRow             = std::min(range.lastRow, static_cast<int>(rows.size()) - 1);
+
+            for (int row = range.firstRow; row <= lastRow; row++) {
+                if (!rows[row].handles.empty()) {
+                    callback(rows[row]);
+                }
+            }
+        }
+    }
+
+    /**
+     * `forEachCell(range, ...)` minus the cells that are also in `excluded`.
+     */
+    template <typename Callback>
+    void forEachCellOutside(const CellRange& range, const CellRange& excluded, Callback&& callback) {
+        if (excluded.empty()) {
+            return forEachCell(range, callback);
+        }
+
+        for (int column = range.firstColumn; column <= range.lastColumn && static_cast<size_t>(column) < m_columns.size(); column++) {
+            std::vector<Cell>& rows = m_columns[column];
+            int lastRow             = std::min(range.lastRow, static_cast<int>(rows.size()) - 1);
+            bool columnExcluded     = column >= excluded.firstColumn && column <= excluded.lastColumn;
+
+            for (int row = range.firstRow; row <= lastRow; row++) {
+                if (columnExcluded && row >= excluded.firstRow && row <= excluded.lastRow) {
+                    row = excluded.lastRow;
+                    continue;
+                }
+
+                if (!rows[row].handles.empty()) {
+                    callback(rows[row]);
+                }
+            }
+        }
+    }
+
+    template <typename Callback>
+    void forEachCell(const CollisionRect& area, Callback&& callback) {
+        forEachCell(cellsFor(area), callback);
+    }
+
+    template <typename Callback>
+    void forEachCell(Callback&& callback) {
+        for (std::vector<Cell>& rows : m_columns) {
+            for (Cell& cell : rows) {
+                if (!cell.handles.empty()) {
+                    callback(cell);
+                }
+            }
+        }
+    }
+
+private:
+    Cell* findCell(int column, int row) {
+        if (static_cast<size_t>(column) >= m_columns.size() || static_cast<size_t>(row) >= m_columns[column].size()) {
+            return nullptr;
+        }
+
+        return &m_columns[column][row];
+    }
+
+private:
+    float m_cellWidth  = 100;
+    float m_cellHeight = 100;
+
+    std::vector<std::vector<Cell>> m_columns; ///< `[column][row]`, rows only go as high as that column needs.
+    size_t m_rowCount = 0;                    ///< Rows of the tallest column.
+
+    float m_maxHalfWidth  = 0;
+    float m_maxHalfHeight = 0;
+    size_t m_size         = 0;
+};
@@ -2,7 +2,9 @@
 
 #include "Extensions/DirectorExt.h"
 #include "Managers/AssetManager.h"
+#include "Objects/ObjectTraits.h"
 #include "Scenes/MenuScene.h"
+#include "Utils/Trace.inl.h"
 
 #include <2d/Sprite.h>
 #include <2d/ActionInstant.h>
@@ -85,6 +87,14 @@ void LoadingLayer::onEnterTransitionDidFinish() {
         },
         [assetManager]() {
             assetManager->addTextureToCache("gravityOverlay.png");
+        },
+        [assetManager]() {
+            // Object particles and the death effect, so level starts and deaths don't parse plists.
+            assetManager->preloadParticle("explodeEffect.plist");
+
+            for (const char* plist : objectParticlePlists()) {
+                assetManager->preloadParticle(plist);
+            }
         }};
 
     ax::Action* act = ax::Sequence::create({
@@ -104,6 +114,8 @@ void LoadingLayer::setBarProgress(float f) {
 }
 
 void LoadingLayer::loadAssets() {
+    TRACE_SCOPE("LoadingLayer::loadAssets");
+
     if (m_currentLoadBatchId >= m_loadBatches.size()) {
         return assetsLoaded();
     }
@@ -11,16 +11,28 @@
 #include <math/Vec2.h>
 #include <platform/FileUtils.h>
 
+#include <string>
+
 Level* createSampleLevel() {
+#ifdef TOMBSTONE_COMPILED_CONTENT_DIR
     ax::FileUtils* const fileUtils = ax::FileUtils::getInstance();
-    std::string data;
 
-    fileUtils->getContents("tombstone/level.txt", &data);
+    // Prefer the compiled level (see tombstone-levelc), it skips text parsing entirely. Only desktop
+    // builds with the host tools have one, rebuilt in the build tree whenever level.txt changes.
+    std::string compiledLevel = TOMBSTONE_COMPILED_CONTENT_DIR "/tombstone/level.tbl";
+
+    if (fileUtils->isFileExist(compiledLevel)) {
+        if (Level* level = Level::createFromFile(compiledLevel)) {
+            return level;
+        }
+    }
+#endif
+
+    if (Level* level = Level::createFromFile("tombstone/level.txt")) {
+        return level;
+    }
 
-    Level* level = Level::create();
-    level->setLevelData(data);
-    
-    return level;
+    return Level::create();
 }
 
 bool MenuScene::init() {
@@ -2,13 +2,17 @@
 
 #include "Managers/AssetManager.h"
 #include "Managers/GameManager.h"
+#include "Managers/InputThread.h"
 #include "Objects/GroundLayer.h"
 #include "Objects/PlayerObject.h"
 #include "Objects/Level.h"
+#include "Objects/LevelLoader.h"
 #include "Objects/LevelSettings.h"
 #include "Objects/GameObject.h"
 #include "Extensions/DirectorExt.h"
-#include "Utils/SplitString.inl.h"
+#include "Scenes/ProfilerOverlay.h"
+#include "Utils/LevelTokenizer.inl.h"
+#include "Utils/Trace.inl.h"
 #include "State.h"
 
 #include <base/EventDispatcher.h>
@@ -19,9 +23,15 @@
 #include <2d/ActionInstant.h>
 #include <2d/ActionEase.h>
 #include <audio/AudioEngine.h>
+#include <platform/FileUtils.h>
 
+#include <chrono>
 #include <vector>
 
+static CollisionRect toCollisionRect(const ax::Rect& rect) {
+    return {rect.getMinX(), rect.getMinY(), rect.getMaxX(), rect.getMaxY()};
+}
+
 const char* getAudioFileName(int id) {
     const char* audioName = "";
 
@@ -68,6 +78,11 @@ void PlayScene::onEnter() {
 
 void PlayScene::onExit() {
     ax::extension::Inspector::getInstance()->close();
+
+    if (m_gameStarted && !m_onLevelEndAnimation) {
+        saveReplay();
+    }
+
     ax::Scene::onExit();
 }
 
@@ -95,13 +110,17 @@ void PlayScene::setupKeybinds() {
                 unscheduled ^= true;
                 break;
             }
+            case ax::EventKeyboard::KeyCode::KEY_F3:
+                m_profiler.setEnabled(!m_profiler.isEnabled());
+                m_profilerOverlay->setVisible(m_profiler.isEnabled());
+                break;
             case ax::EventKeyboard::KeyCode::KEY_UP_ARROW:
-                if (playerButtonHeld) {
+                if (playerButtonHeld || m_inputThread) {
                     break;
                 }
 
                 playerButtonHeld = true;
-                m_player->pushButton(PlayerButton::Unk);
+                pushButton();
                 
                 break;
             default:
@@ -112,12 +131,12 @@ void PlayScene::setupKeybinds() {
     keyboardListener->onKeyReleased = [this](ax::EventKeyboard::KeyCode key, ax::Event*) {
         switch (key) {
             case ax::EventKeyboard::KeyCode::KEY_UP_ARROW:
-                if (!playerButtonHeld) {
+                if (!playerButtonHeld || m_inputThread) {
                     break;
                 }
 
                 playerButtonHeld = false;
-                m_player->releaseButton(PlayerButton::Unk);
+                releaseButton();
                 break;
             default:
                 break;
@@ -139,12 +158,12 @@ void PlayScene::setupTouchControls() {
     };
 
     touchListener->onTouchBegan = [this](ax::Touch*, ax::Event*) {
-        m_player->pushButton(PlayerButton::Unk);
+        pushButton();
         return true;
     };
 
     touchListener->onTouchEnded = [this](ax::Touch*, ax::Event*) {
-        m_player->releaseButton(PlayerButton::Unk);
+        releaseButton();
         return true;
     };
 
@@ -152,7 +171,124 @@ void PlayScene::setupTouchControls() {
         ->addEventListenerWithSceneGraphPriority(touchListener, this);
 }
 
+void PlayScene::pushButton() {
+    if (!m_playingReplay) {
+        m_inputQueue.push_back({std::chrono::steady_clock::now(), true});
+    }
+}
+
+void PlayScene::releaseButton() {
+    if (!m_playingReplay) {
+        m_inputQueue.push_back({std::chrono::steady_clock::now(), false});
+    }
+}
+
+/**
+ * Works out when the queued input arrived in simulated time and which tick boundary that is. The
+ * tick loop then applies it there instead of at the start of the frame, which is up to a frame late.
+ */
+void PlayScene::scheduleQueuedInput() {
+    if (m_inputThread) {
+        InputThread::ButtonEdge edge;
+        bool merged = false;
+
+        while (m_inputThread->popEdge(edge)) {
+            if (!m_playingReplay && edge.button == PlayerButton::Unk) {
+                m_inputQueue.push_back({edge.time, edge.press});
+                merged = true;
+            }
+        }
+
+        // Touches still come from the event dispatcher.
+        if (merged) {
+            std::stable_sort(m_inputQueue.begin(), m_inputQueue.end(),
+                             [](const QueuedInput& lhs, const QueuedInput& rhs) { return lhs.time < rhs.time; });
+        }
+    }
+
+    const auto now          = std::chrono::steady_clock::now();
+    const double simNow     = m_physicsClock.getTime();
+    const uint64_t nextTick = m_physicsClock.getTick(); // ticks before that already ran
+
+    for (const QueuedInput& input : m_inputQueue) {
+        double age    = std::chrono::duration<double>(now - input.time).count();
+        uint64_t tick = std::max(m_physicsClock.tickAt(simNow - age), nextTick);
+
+        if (!m_scheduledInput.empty()) {
+            tick = std::max(tick, m_scheduledInput.back().tick);
+        }
+
+        m_scheduledInput.push_back({tick, input.press});
+    }
+
+    m_inputQueue.clear();
+}
+
+void PlayScene::applyQueuedInput(uint64_t tick) {
+    auto it = m_scheduledInput.begin();
+
+    for (; it != m_scheduledInput.end() && it->tick <= tick; ++it) {
+        m_recording.record(it->tick, it->press);
+
+        if (it->press) {
+            m_player->pushButton(PlayerButton::Unk);
+        } else {
+            m_player->releaseButton(PlayerButton::Unk);
+        }
+    }
+
+    m_scheduledInput.erase(m_scheduledInput.begin(), it);
+}
+
+/**
+ * Applies whatever input is still waiting right away, so the button is in the state the player left
+ * it in when the level resets.
+ */
+void PlayScene::flushQueuedInput() {
+    scheduleQueuedInput();
+
+    for (const replay_format::Event& event : m_scheduledInput) {
+        if (event.press) {
+            m_player->pushButton(PlayerButton::Unk);
+        } else {
+            m_player->releaseButton(PlayerButton::Unk);
+        }
+    }
+
+    m_scheduledInput.clear();
+}
+
+void PlayScene::applyReplayInput(uint64_t tick) {
+    const auto& events = m_playback.events;
+
+    for (; m_playbackCursor < events.size() && events[m_playbackCursor].tick <= tick; m_playbackCursor++) {
+        if (events[m_playbackCursor].press) {
+            m_player->pushButton(PlayerButton::Unk);
+        } else {
+            m_player->releaseButton(PlayerButton::Unk);
+        }
+    }
+}
+
+/**
+ * Keeps the last attempt as `last_attempt.tbrp` in the writable path, to be played back through
+ * `GameManager::setReplayPath` or `tombstone-sim --replay`.
+ */
+void PlayScene::saveReplay() {
+    if (m_playingReplay || m_physicsClock.getTick() == 0) {
+        return;
+    }
+
+    m_recording.tickCount = m_physicsClock.getTick();
+
+    ax::FileUtils* const fileUtils = ax::FileUtils::getInstance();
+    fileUtils->writeStringToFile(replay_format::encode(m_recording), fileUtils->getWritablePath() + "last_attempt.tbrp");
+}
+
 PlayScene::~PlayScene() {
+    m_levelLoader.reset();
+    m_inputThread.reset();
+
     if (m_level) {
         m_level->release();
     }
@@ -176,6 +312,26 @@ bool PlayScene::init(Level* level) {
 
     level->retain();
     m_level = level;
+    m_lazyObjects = gameManager->getLazyObjects();
+    m_collisionGrid.setCellSize(gameManager->getGridCellWidth(), gameManager->getGridCellHeight());
+    m_collisionMode = gameManager->getCollisionMode();
+    m_physicsClock.setTickRate(m_collisionMode == CollisionMode::Swept ? FixedTimestep::SWEPT_TICK_RATE
+                                                                       : FixedTimestep::SUBSTEP_TICK_RATE);
+    m_recording.tickRate = static_cast<uint16_t>(m_physicsClock.getTickRate());
+
+    if (const std::string& replayPath = gameManager->getReplayPath(); !replayPath.empty()) {
+        std::string replayData;
+        ax::FileUtils::getInstance()->getContents(replayPath, &replayData);
+
+        // Only plays back the way it was recorded at the same tick rate.
+        m_playingReplay = replay_format::decode(replayData, m_playback) &&
+                          m_playback.tickRate == m_physicsClock.getTickRate();
+    }
+
+    if (gameManager->getInputThread() && InputThread::isSupported()) {
+        m_inputThread = std::make_unique<InputThread>();
+        m_inputThread->start();
+    }
 
     State::getInstance()->setPlayLayer(this);
 
@@ -295,15 +451,19 @@ bool PlayScene::init(Level* level) {
     {
         std::string spriteSheetName = assetManager->getForwardedFileName("GJ_GameSheet.png");
 
-        m_batchNode = ax::SpriteBatchNode::create(spriteSheetName);
-        m_additiveBatchNode = ax::SpriteBatchNode::create(spriteSheetName);
+        m_batchNode = ObjectBatchNode::create(spriteSheetName);
+        m_additiveBatchNode = ObjectBatchNode::create(spriteSheetName);
         m_playerBatchNode = ax::SpriteBatchNode::create(spriteSheetName);
     }
 
     m_additiveBatchNode->setBlendFunc(ax::BlendFunc::ADDITIVE);
 
+    // Additive like `m_additiveBatchNode`, which the glow sprites used to be in.
+    m_glowBatchNode = GlowBatchNode::create(assetManager->getForwardedFileName("GJ_GameSheet.png"));
+
     m_gameLayer->addChild(m_batchNode, 1);
     m_gameLayer->addChild(m_additiveBatchNode, 0);
+    m_gameLayer->addChild(m_glowBatchNode, 0);
     m_gameLayer->addChild(m_playerBatchNode, 1);
 #pragma endregion BatchNodes
 
@@ -318,7 +478,19 @@ bool PlayScene::init(Level* level) {
 #pragma endregion Player
 
 
-    createObjectsFromSetup(level->getLevelData());
+    if (level->isBinary()) {
+        m_levelSettings = LevelSettings::objectFromString(level->getBinaryView().getSettings());
+    } else {
+        m_levelSettings = LevelSettings::objectFromString(level_tokenizer::split_header(level->getLevelData()).first);
+    }
+
+    m_levelSettings->retain();
+
+    // Objects are parsed on a worker and built a few sections per frame, see updateLevelLoading.
+    GameObject::loadObjectDictionary();
+    m_levelLoader = std::make_unique<LevelLoader>();
+    m_levelLoader->start(level);
+    schedule(AX_SCHEDULE_SELECTOR(PlayScene::updateLevelLoading));
     
     updateCamera(0);
     updateVisibility();
@@ -335,6 +507,11 @@ bool PlayScene::init(Level* level) {
     m_gameLayer->addChild(m_debugDrawNode, 1000);
     m_debugDrawNode->clear();
 
+    // Toggled with F3.
+    m_profilerOverlay = ProfilerOverlay::create(&m_profiler);
+    m_profilerOverlay->setVisible(false);
+    this->addChild(m_profilerOverlay, 1000);
+
     // Uncomment to see hitboxes
     /*for (auto object : m_objects) {
         if (object->getIsDisabled()) {
@@ -361,22 +538,40 @@ bool PlayScene::init(Level* level) {
 
 void PlayScene::update(float dt)
 {
+    TRACE_SCOPE("PlayScene::update");
+
     float relativeDelta = dt * 60.0f;
 
+    m_profiler.nextFrame();
+
     if (!m_player->getIsLocked()) {
         m_player->setPosition(m_lastPlayerPos);
     }
 
-    m_player->setTouchedRing(nullptr);
+    // Physics runs in fixed ticks whatever the refresh rate is, the frame only decides how many.
+    m_physicsClock.addTime(dt);
+    scheduleQueuedInput();
 
-    int steps = std::max(static_cast<int>(roundf(relativeDelta * 4.0f)), 4);
-    float deltaPerStep = relativeDelta / static_cast<float>(steps);
+    while (!m_onLevelEndAnimation && m_physicsClock.step()) {
+        if (m_playingReplay) {
+            applyReplayInput(m_physicsClock.getTick() - 1);
+        } else {
+            applyQueuedInput(m_physicsClock.getTick() - 1);
+        }
+
+        // Orbs can be used for a whole 60 Hz frame after touching them, not just a single tick.
+        if ((m_physicsClock.getTick() - 1) % m_physicsClock.getTicksPerFrame() == 0) {
+            m_player->setTouchedRing(nullptr);
+        }
+
+        m_previousTickPlayerPos = m_player->getPosition();
 
-    if (!m_onLevelEndAnimation && steps > 0) {
-        for (int i = 0; i != steps && !m_onLevelEndAnimation; ++i) {
-            m_player->update(deltaPerStep);
-            checkCollisions(deltaPerStep);
+        {
+            FrameProfiler::Scope profile(m_profiler, FrameProfiler::Physics);
+            m_player->update(m_physicsClock.getTickDelta());
         }
+
+        checkCollisions();
     }
     
     if (m_player->getFlyMode()) {
@@ -385,6 +580,10 @@ void PlayScene::update(float dt)
 
     if (!m_player->getIsLocked()) {
         m_lastPlayerPos = m_player->getPosition();
+
+        // Drawn in between the last two ticks, the physics position comes back at the start of the next frame.
+        float alpha = m_onLevelEndAnimation ? 1.0f : m_physicsClock.getAlpha();
+        m_player->setPosition(m_previousTickPlayerPos.lerp(m_lastPlayerPos, alpha));
     }
 
     if (m_player->getIsLocked() || m_flipProgress == 1.0 || m_flipProgress == 0.0) {
@@ -461,74 +660,28 @@ void PlayScene::tintGround(ax::Color3B color, float time) {
     }
 }
 
-const std::string PlayScene::getParticleKey(
+ParticlePool::Id PlayScene::internParticle(
     int objType, const char* particleName, int unk, ax::ParticleSystem::PositionType posType)
 {
-    return fmt::format("{}{}{}{}", objType, particleName, unk, static_cast<int>(posType));
-}
-
-const std::string PlayScene::getParticleKey2(const std::string particle) {
-    return fmt::format("{}2", particle);
+    return m_particlePool.intern(objType, particleName, unk, posType);
 }
 
-ax::ParticleSystemQuad* PlayScene::createParticle(int objType,
-                                             const char* particleName,
-                                             int unk,
-                                             ax::ParticleSystem::PositionType posType)
-{
-    constexpr size_t MAX_PARTICLES_PER_KEY = 0x13;
-
-    auto particleKey = getParticleKey(objType, particleName, unk, posType);
-
-    if (!m_particleDictionary.contains(particleKey)) {
-        m_particleDictionary[particleKey] = {};
-        m_particleDictionary[getParticleKey2(particleKey)] = {};
-    }
-
-    auto& array = m_particleDictionary[particleKey];
-
-    if (array.size() <= MAX_PARTICLES_PER_KEY) {
-        auto particle = ax::ParticleSystemQuad::create(particleName);
-        particle->setTag(unk);
-        particle->setPositionType(posType);
-        particle->stopSystem();
-
-        array.pushBack(particle);
-        m_gameLayer->addChild(particle, unk);
-
-        return particle;
-    }
-
-    return nullptr;
+ax::ParticleSystemQuad* PlayScene::createParticle(ParticlePool::Id id) {
+    return m_particlePool.create(id, m_gameLayer);
 }
 
-ax::ParticleSystemQuad* PlayScene::claimParticle(std::string key) {
-    if (!m_particleDictionary.contains(key) || !m_particleDictionary[key].size())
-        return nullptr;
-
-    auto& unkArr = m_particleDictionary[key];
-    auto lastObj = unkArr.back();
-
-    m_particleDictionary[getParticleKey2(key)].pushBack(lastObj);
-    unkArr.eraseObject(unkArr.back());
-    lastObj->setVisible(true);
-
-    return lastObj;
+ax::ParticleSystemQuad* PlayScene::claimParticle(ParticlePool::Id id, bool transformed) {
+    return m_particlePool.claim(id, transformed);
 }
 
-void PlayScene::unclaimParticle(const char* key, ax::ParticleSystemQuad* particleSystem) {
-    if (!particleSystem || !m_particleDictionary.contains(key)) {
-        return;
-    }
-
-    m_particleDictionary[key].pushBack(particleSystem);
-    m_particleDictionary[getParticleKey2(key)].eraseObject(particleSystem, false);
-    particleSystem->setVisible(false);
+void PlayScene::unclaimParticle(ParticlePool::Id id, ax::ParticleSystemQuad* particleSystem) {
+    m_particlePool.unclaim(id, particleSystem);
 }
 
+void PlayScene::checkCollisions() {
+    TRACE_SCOPE("PlayScene::checkCollisions");
+    FrameProfiler::Scope profile(m_profiler, FrameProfiler::Collisions);
 
-
-void PlayScene::checkCollisions(float dt) {
     if (m_player->getPositionY() < 105 && !m_player->getFlyMode()) {
         if (m_player->getGravityFlipped()) {
             destroyPlayer();
@@ -555,142 +708,97 @@ void PlayScene::checkCollisions(float dt) {
         }
     }
 
-    int sectionId = sectionForPos(m_player->getPosition());
-
-    for (int sectionIndex = sectionId - 1; sectionIndex <= sectionId + 1; sectionIndex++) {
-        if (sectionIndex < 0 || m_sections.size() <= sectionIndex) {
-            continue;
-        }
-
-        auto section = m_sections[sectionIndex];
-
-        for (auto object : section) {
-            if (object->getType() == GameObjectType::Hazard) {
-                m_hazards.pushBack(object);
-                continue;
-            }
-
-            if (object->getIsDisabled() || object->getHasBeenActivated() ||
-                !m_player->getObjectRect().intersectsRect(object->getObjectRect()))
-            {
-                continue;
-            }
-
-            GameObjectType type = object->getType();
-
-            switch (type)
-            {
-            case GameObjectType::InvertGravityPortal:
-                if (!m_player->getGravityFlipped()) {
-                    this->playGravityEffect(true);
-                }
-
-                m_player->setPortalP(object->getPosition());
-                m_player->flipGravity(true);
-                object->triggerActivated();
-
-                break;
-
-            case GameObjectType::NormalGravityPortal:
-                if (m_player->getGravityFlipped()) {
-                    this->playGravityEffect(false);
-                }
+    bool hitHazard = false;
 
-                m_player->setPortalP(object->getPosition());
-                m_player->flipGravity(false);
-                object->triggerActivated();
-
-                break;
-            case GameObjectType::ShipPortal:
-                switchToFlyMode(object, false);
-                object->triggerActivated();
+    if (m_collisionMode == CollisionMode::Swept) {
+        CollisionRect startRect = sweepStartRect(getPlayerRect());
+        hitHazard               = m_objectCollision.collideSwept(m_collisionGrid, m_hazardIndex, startRect, *this);
+    } else {
+        hitHazard = m_objectCollision.collideOverlapping(m_collisionGrid, m_hazardIndex, *this);
+    }
 
-                break;
-            case GameObjectType::CubePortal:
-                m_player->setPortalP(object->getPosition());
+    // Only the first hazard hit matters, the original loop over m_hazards broke out right after
+    // destroyPlayer. Running into every spike of a row used to slow the game to a crawl
+    // (it also happens in the original game).
+    if (hitHazard) {
+        this->destroyPlayer();
+    }
+}
 
-                exitFlyMode();
-                exitRollMode();
+CollisionRect PlayScene::sweepStartRect(const CollisionRect& playerRect) const {
+    ax::Vec2 delta = m_player->getPosition() - m_player->getPreviousPosition();
+    return {playerRect.minX - delta.x, playerRect.minY - delta.y, playerRect.maxX - delta.x, playerRect.maxY - delta.y};
+}
 
-                object->triggerActivated();
+CollisionRect PlayScene::getPlayerRect() const {
+    return toCollisionRect(m_player->getObjectRect());
+}
 
-                break;
-            case GameObjectType::YellowPad:
-                m_player->setPortalP({object->getPosition().x, object->getPosition().y - 10});
-                object->triggerActivated();
-                m_player->propellPlayer(1.0);
+bool PlayScene::getGravityFlipped() const {
+    return m_player->getGravityFlipped();
+}
 
-                break;
-            case GameObjectType::GravityPad: {
-                bool flipped = (std::fabs(object->getRotation()) == 180);
+bool PlayScene::isObjectActivated(GameObject* object) const {
+    return object->getHasBeenActivated();
+}
 
-                if (!object->isFlippedY()) {
-                    flipped ^= true;
-                }
+void PlayScene::setObjectActivated(GameObject* object) {
+    object->triggerActivated();
+}
 
-                if (flipped != m_player->getGravityFlipped()) {
-                    //self->playGravityEffect(flipped);
-                    auto objectPosition = object->getPosition();
-                    m_player->setPortalP({objectPosition.x, objectPosition.y - 10});
-                    object->triggerActivated();
-                    m_player->propellPlayer(0.8f);
-                    m_player->flipGravity(flipped);
-                }
+float PlayScene::getObjectRotation(GameObject* object) const {
+    return object->getRotation();
+}
 
-                break;
-            }
-            case GameObjectType::YellowOrb:
-                [[fallthrough]];
-            case GameObjectType::BlueOrb:
-                m_player->setTouchedRing(object);
-                //object->powerOnObject();
-                m_player->ringJump();
+bool PlayScene::isObjectFlippedY(GameObject* object) const {
+    return object->isFlippedY();
+}
 
-                break;
-            case GameObjectType::MirrorPortal:
-                m_player->setPortalP(object->getPosition());
-                m_player->setPortalObject(object);
-                toggleFlipped(true, false);
+void PlayScene::onGravityPortal(GameObject* portal, bool flip) {
+    if (flip != m_player->getGravityFlipped()) {
+        this->playGravityEffect(flip);
+    }
 
-                object->triggerActivated();
+    m_player->setPortalP(portal->getPosition());
+    m_player->flipGravity(flip);
+}
 
-                break;
-            case GameObjectType::CounterMirrorPortal:
-                m_player->setPortalP(object->getPosition());
-                m_player->setPortalObject(object);
-                toggleFlipped(false, false);
+void PlayScene::onShipPortal(GameObject* portal) {
+    switchToFlyMode(portal, false);
+}
 
-                object->triggerActivated();
+void PlayScene::onBallPortal(GameObject* portal) {
+    switchToRollMode(portal, false);
+}
 
-                break;
-            case GameObjectType::BallPortal:
-                switchToRollMode(object, false);
-                object->triggerActivated();
+void PlayScene::onCubePortal(GameObject* portal) {
+    m_player->setPortalP(portal->getPosition());
 
-                break;
-                
-            default:
-                m_player->collidedWithObject(dt, object);
-                break;
-            }
-        }
-    }
+    exitFlyMode();
+    exitRollMode();
+}
 
-    for (auto hazard : m_hazards) {
-        if (m_player->getObjectRect().intersectsRect(hazard->getObjectRect())) {
-            this->destroyPlayer();
+void PlayScene::onMirrorPortal(GameObject* portal, bool mirrored) {
+    m_player->setPortalP(portal->getPosition());
+    m_player->setPortalObject(portal);
+    toggleFlipped(mirrored, false);
+}
 
-            // - replace the `break` below with `return`
-            // - change destroyPlayer to do an early return,
-            // - run through a bunch of ground spikes,
-            // - watch as the game starts running to a crawl :)
-            // (I probably made a mistake while decompiling this but it also happens in the original game)
+void PlayScene::onPad(GameObject* pad, float force, bool gravityFlipped) {
+    //self->playGravityEffect(flipped);
+    m_player->setPortalP({pad->getPosition().x, pad->getPosition().y - 10});
+    m_player->propellPlayer(force);
+    m_player->flipGravity(gravityFlipped);
+}
 
-            break;
-        }
-    }
+void PlayScene::onOrb(GameObject* orb, GameObjectType) {
+    m_player->setTouchedRing(orb);
+    //object->powerOnObject();
+    m_player->ringJump();
+}
 
-    m_hazards.clear();
+void PlayScene::onBlock(GameObject* block, const CollisionRect&) {
+    m_player->collidedWithObject(block);
 }
 
 void PlayScene::destroyPlayer() {
@@ -702,6 +810,7 @@ void PlayScene::destroyPlayer() {
 
     m_onLevelEndAnimation = true;
     m_player->playerDestroyed();
+    saveReplay();
 
     ax::AudioEngine::play2d("explode_11.ogg", false, 0.6);
 
@@ -796,6 +905,8 @@ void PlayScene::exitRollMode() {
 }
 
 void PlayScene::updateCamera(float dt) {
+    FrameProfiler::Scope profile(m_profiler, FrameProfiler::Camera);
+
     ax::Director* const director = ax::Director::getInstance();
     const ax::Size winSize  = director->getWinSize();
 
@@ -970,12 +1081,19 @@ void PlayScene::cameraMoveY(float y, float t, float r) {
 }
 
 void PlayScene::updateVisibility() {
+    TRACE_SCOPE("PlayScene::updateVisibility");
+    FrameProfiler::Scope profile(m_profiler, FrameProfiler::Visibility);
+
     auto cameraPos = this->m_cameraPos;
     auto director          = ax::Director::getInstance();
 
     int previousSection = floorf(cameraPos.x / 100.0f) - 1;
     int nextSection     = ceilf((cameraPos.x + ax::Director::getInstance()->getWinSize().width) / 100.0f) + 1;
 
+    if (m_lazyObjects) {
+        updateMaterializedSections(previousSection, nextSection);
+    }
+
     bool isFlipping = this->isFlipping();
     float audioScale       = 1;
 
@@ -1016,50 +1134,128 @@ void PlayScene::updateVisibility() {
         }
     };
 
+    // Same sections as before, but only up to a screen above and below the camera. That's enough
+    // for objects to have their enter effect set up before the camera moves to them.
+    const ax::Size& winSize = director->getWinSize();
+    CollisionRect visibleArea {previousSection * 100.0f, cameraPos.y - winSize.height,
+                               nextSection * 100.0f - 0.01f, cameraPos.y + winSize.height * 2};
+
+    SpatialGrid<GameObject*>::CellRange visibleCells, leftBand, rightBand;
+
     if (previousSection <= nextSection) {
-        for (int i = previousSection; i < nextSection; i++) {
-            if (i < 0 || i >= m_sections.size()) {
-                continue;
-            }
+        visibleCells = m_collisionGrid.cellsForCenters(visibleArea);
+
+        // Everything between the window edges and the end of the opacity and enter effect fades,
+        // padded by a cell since the fades go by real position and the grid by hitbox center.
+        float fade = 70 + m_collisionGrid.getCellWidth();
+        leftBand   = m_collisionGrid.cellsForCenters({visibleArea.minX, visibleArea.minY, cameraPos.x + fade, visibleArea.maxY});
+        rightBand  = m_collisionGrid.cellsForCenters(
+            {cameraPos.x + winSize.width - fade, visibleArea.minY, visibleArea.maxX, visibleArea.maxY});
+    }
 
-            // Process each section up until the furthest on the screen
-            ax::Vector<GameObject*> section = m_sections[i];
+    // Fades and enter effects are queued here and run for all objects at once below.
+    m_enterEffectQueue.clear();
 
-            for (auto object : section) {
-                object->activateObject();
+    auto updateObject = [&](GameObject* object) {
+        if (object->getUseAudioScale()) {
+            object->setScale(audioScale);
+        }
 
-                if (object->getUseAudioScale()) {
-                    object->setScale(audioScale);
-                }
+        float sc = (object->getType() == GameObjectType::UnknownType)
+                       ? (object->getObjectRect().size.width * object->getScaleX()) * 0.4
+                       : 0;
 
-                float sc = (object->getType() == GameObjectType::UnknownType)
-                               ? (object->getObjectRect().size.width * object->getScaleX()) * 0.4
-                               : 0;
+        if (!object->getDontTransform()) {
+            this->queueEnterEffect(object, sc, winSize);
+        } else {
+            object->updateQuad();
+        }
+    };
 
-                if (!object->getDontTransform()) {
-                    object->setOpacity(this->getRelativeMod(object->getRealPosition(), 70, 70, sc) * 255);
-                    this->applyEnterEffect(object);
+    auto activateCell = [&](auto& cell) {
+        for (GameObject* object : cell.handles) {
+            object->activateObject();
+            updateObject(object);
+        }
+    };
 
-                    if (isFlipping) {
-                        apply_flip_effect(object);
-                    }
-                }
+    auto updateCell = [&](auto& cell) {
+        for (GameObject* object : cell.handles) {
+            updateObject(object);
+        }
+    };
+
+    // The flip effect moves every object, and after a reset nothing can be trusted to be in place.
+    bool refresh = m_refreshVisibility || isFlipping || m_wasFlipping;
+
+    if (refresh) {
+        m_collisionGrid.forEachCell(visibleCells, activateCell);
+    } else {
+        SpatialGrid<GameObject*>::CellRange stayedCells = visibleCells.intersect(m_visibleCells);
+
+        // Built since the last frame into cells that were already on screen.
+        for (GameObject* object : m_newObjects) {
+            CollisionRect rect = toCollisionRect(object->getObjectRect());
+
+            if (stayedCells.contains(m_collisionGrid.columnForX((rect.minX + rect.maxX) / 2),
+                                     m_collisionGrid.rowForY((rect.minY + rect.maxY) / 2)))
+            {
+                object->activateObject();
+                updateObject(object);
             }
         }
+
+        m_collisionGrid.forEachCellOutside(visibleCells, m_visibleCells, activateCell);
+
+        // Objects in the middle of the screen sit at full opacity with their enter effect done, only
+        // the fades need updating. Last frame's bands too, so objects leaving them end up at 0 or 1.
+        m_collisionGrid.forEachCell(leftBand.merge(m_leftBand).intersect(stayedCells), updateCell);
+        m_collisionGrid.forEachCellOutside(rightBand.merge(m_rightBand).intersect(stayedCells),
+                                           leftBand.merge(m_leftBand), updateCell);
     }
 
-    if (this->m_nextSection >= this->m_previousSection) {
-        for (int i = m_previousSection; i < this->m_nextSection; i++) {
-            if (i < 0 || i >= m_sections.size()) {
-                continue;
-            }
+    // Every active object is in the batch, running them all beats gathering the queued ones.
+    if (!m_enterEffectQueue.empty()) {
+        enter_effect::run(m_enterEffectBatch, cameraPos.x, winSize.width / 2);
+    }
 
-            for (GameObject* object : m_sections[i]) {
-                object->deactivateObject();
-            }
+    for (GameObject* object : m_enterEffectQueue) {
+        size_t i = static_cast<size_t>(object->getEnterEffectSlot());
+
+        object->setOpacity(m_enterEffectBatch.opacity[i]);
+        object->setPosition(object->getRealPosition() +
+                            ax::Vec2 {m_enterEffectBatch.offsetX[i], m_enterEffectBatch.offsetY[i]});
+
+        if (!object->getUseAudioScale()) {
+            ax::Vec2 newScale = object->getStartScale() * m_enterEffectBatch.scale[i];
+            object->setScale(newScale.x, newScale.y);
+        }
+
+        float relativeMod = m_enterEffectBatch.relativeMod[i];
+
+        if (relativeMod == 1 || relativeMod == 0) {
+            object->setEnterEffect(0);
         }
+
+        if (isFlipping) {
+            apply_flip_effect(object);
+        }
+
+        object->updateQuad();
     }
 
+    m_collisionGrid.forEachCellOutside(m_visibleCells, visibleCells, [](auto& cell) {
+        for (GameObject* object : cell.handles) {
+            object->deactivateObject();
+        }
+    });
+
+    m_newObjects.clear();
+    m_refreshVisibility = false;
+    m_wasFlipping       = isFlipping;
+    m_visibleCells      = visibleCells;
+    m_leftBand          = leftBand;
+    m_rightBand         = rightBand;
     m_previousSection = previousSection;
     m_nextSection     = nextSection;
 }
@@ -1094,28 +1290,6 @@ bool PlayScene::isFlipping() const
     return false;
 }
 
-float PlayScene::getRelativeMod(ax::Vec2 pos, float a2, float a3, float a4) {
-    float screenWidth = ax::Director::getInstance()->getWinSize().width / 2;
-    float camX        = m_cameraPos.x;
-
-    float unk, unk2;
-
-    if (pos.x <= (camX + screenWidth)) {
-        unk = a3;
-        unk2 = ((camX + screenWidth) - pos.x) - a4;
-    } else {
-        unk = a2;
-        unk2 = ((pos.x - a4) - camX) - screenWidth;
-    }
-
-    if (unk < 1.0) {
-        unk = 1.0;
-    }
-
-    float res = (screenWidth - unk2) / unk;
-    return std::clamp(res, 0.0f, 1.0f);
-}
-
 void PlayScene::animateInFlyGround(bool instant) {
     if (m_flyGroundActive) {
         return;
@@ -1168,91 +1342,51 @@ void PlayScene::animateOutFlyGround(bool instant) {
     m_flyGround.top->runAction(ax::FadeOut::create(0.4));
 }
 
-void PlayScene::createObjectsFromSetup(std::string setup) {
-    auto [headerSetup, dataSetup] = split_string::split_to_pair(setup, ";");
+void PlayScene::updateLevelLoading(float) {
+    TRACE_SCOPE("PlayScene::updateLevelLoading");
 
-    m_levelSettings = LevelSettings::objectFromString(headerSetup);
-    m_levelSettings->retain();
+    using clock = std::chrono::steady_clock;
 
-    split_string::split_streamed(dataSetup, ";", [this](std::string_view setup) {
-        GameObject* object = GameObject::createFromString(setup);
+    if (!m_levelInfoApplied) {
+        LevelLoader::LevelInfo info;
 
-        if (!object) {
+        if (!m_levelLoader->getLevelInfo(info)) {
             return;
         }
 
-        object->setVisible(false);
+        ensureSectionCount(info.sectionCount);
 
-        if (object->getStartPosition().x > m_maxObjectXPos) {
-            m_maxObjectXPos = object->getStartPosition().x;
+        if (info.hasStartPos && info.startX > m_startPos.x) {
+            m_startPos = {info.startX, info.startY};
+            m_testMode = true;
         }
 
-        if (object->getBlendAdditive()) {
-            if (object->getUsePlayerColor()) {
-                object->setColor(m_player->getColor());
-            } else if (object->getUsePlayerColor2()) {
-                GameManager* gm = GameManager::singleton();
-                object->setColor(gm->colorForIdx(gm->getPlayerColor2()));
-            }
-            object->setObjectParent(m_additiveBatchNode);
-        } else {
-            object->setObjectParent(m_batchNode);
-        }
+        m_levelInfoApplied = true;
+    }
 
-        addToSection(object);
-        m_objects.pushBack(object);
+    // Keep the frame going while sections stream in, the rest is picked up next frame.
+    const auto deadline = clock::now() + std::chrono::milliseconds(m_gameStarted ? 2 : 8);
+    LevelLoader::SectionBatch batch;
 
-        if (object->getShouldSpawn()) {
-            m_spawnObjects.pushBack(object);
-            object->calculateSpawnXPos();
+    while (clock::now() < deadline && m_levelLoader->popBatch(batch)) {
+        for (const ObjectDescriptor& desc : batch.objects) {
+            createObjectFromDescriptor(desc);
         }
+    }
 
-        auto frame = object->getFrame();
-
-        if (object->getObjectKey() == 31) {
-            if (object->getPosition().x > m_startPos.x) {
-                m_startPos = object->getPosition();
-                m_testMode = true;
-            }
-        } else if (frame.starts_with("rod_0")) {
-            //TODO: The pulse things
-        } else if (frame.starts_with("portal_0")) {
-            std::string backPortalTexture;
-
-            if (frame == "portal_01_front_001.png")
-                backPortalTexture = "portal_01_back_001.png";
-            else if (frame == "portal_02_front_001.png")
-                backPortalTexture = "portal_02_back_001.png";
-            else if (frame == "portal_03_front_001.png")
-                backPortalTexture = "portal_03_back_001.png";
-            else if (frame == "portal_04_front_001.png")
-                backPortalTexture = "portal_04_back_001.png";
-            else if (frame == "portal_05_front_001.png")
-                backPortalTexture = "portal_05_back_001.png";
-            else if (frame == "portal_06_front_001.png")
-                backPortalTexture = "portal_06_back_001.png";
-            else if (frame == "portal_07_front_001.png")
-                backPortalTexture = "portal_07_back_001.png";
-            else
-                backPortalTexture = "portal_01_back_001.png";
-
-            GameObject* back = GameObject::create(backPortalTexture);
-            back->setObjectKey(38);
-            back->customSetup();
-
-            back->setStartPosition(object->getPosition());
-            back->setObjectParent(m_batchNode);
-            back->setObjectZ(-1);
+    if (m_startGameQueued && m_levelLoader->isStartWindowReady()) {
+        m_startGameQueued = false;
+        startGame();
+    }
 
-            back->setFlippedX(object->isFlippedX());
-            back->setFlippedY(object->isFlippedY());
+    if (m_levelLoader->isFinished()) {
+        finishLevelLoading();
+    }
+}
 
-            back->setRotation(object->getRotation());
-            back->setStartRotation(object->getRotation());
-
-            addToSection(back);
-        }
-    });
+void PlayScene::finishLevelLoading() {
+    unschedule(AX_SCHEDULE_SELECTOR(PlayScene::updateLevelLoading));
+    m_levelLoader.reset();
 
     ax::Director* const director = ax::Director::getInstance();
     float screenLeft = director->getWinSize().width;
@@ -1268,23 +1402,216 @@ void PlayScene::createObjectsFromSetup(std::string setup) {
     //TODO: End portal object
 }
 
-void PlayScene::addToSection(GameObject* obj) {
-    auto section = sectionForPos(obj->getPosition());
+void PlayScene::createObjectFromDescriptor(const ObjectDescriptor& desc) {
+    // Spawn triggers have to exist off-screen, everything else can wait for its section to show up.
+    if (m_lazyObjects && !GameObject::traitsForKey(desc.objectKey).shouldSpawn) {
+        int section = std::max(sectionForPos({desc.x, desc.y}), 0);
+        ensureSectionCount(section + 1);
+
+        m_sectionDescriptors[section].push_back(desc);
+
+        if (desc.x > m_maxObjectXPos) {
+            m_maxObjectXPos = desc.x;
+        }
+
+        // Streamed in while the section is already on screen.
+        if (m_sectionMaterialized[section]) {
+            buildObject(desc);
+        }
+
+        return;
+    }
+
+    if (GameObject* object = buildObject(desc)) {
+        m_objects.pushBack(object);
+    }
+}
+
+GameObject* PlayScene::buildObject(const ObjectDescriptor& desc) {
+    GameObject* object = m_objectPool.createFromDescriptor(desc);
+
+    if (!object) {
+        return nullptr;
+    }
+
+    object->setVisible(false);
+
+    if (object->getStartPosition().x > m_maxObjectXPos) {
+        m_maxObjectXPos = object->getStartPosition().x;
+    }
+
+    if (object->getBlendAdditive()) {
+        if (object->getUsePlayerColor()) {
+            object->setColor(m_player->getColor());
+        } else if (object->getUsePlayerColor2()) {
+            GameManager* gm = GameManager::singleton();
+            object->setColor(gm->colorForIdx(gm->getPlayerColor2()));
+        }
+        object->setObjectParent(m_additiveBatchNode);
+    } else {
+        object->setObjectParent(m_batchNode);
+    }
+
+    addToSection(object);
+
+    if (object->getShouldSpawn()) {
+        m_spawnObjects.pushBack(object);
+        object->calculateSpawnXPos();
 
-    if (m_sections.size() < (section + 1)) {
-        while (m_sections.size() < (section + 1)) {
-            m_sections.emplace_back();
+        // Streamed in after resetLevel already built the queue.
+        if (m_gameStarted) {
+            auto it = std::upper_bound(m_spawnQueue.begin(), m_spawnQueue.end(), object,
+                [](GameObject* lhs, GameObject* rhs) { return lhs->getSpawnXPos() < rhs->getSpawnXPos(); });
+            m_spawnQueue.insert(std::distance(m_spawnQueue.begin(), it), object);
         }
     }
 
+    const std::string& frame = object->getFrame();
+
+    if (object->getObjectKey() == 31) {
+        if (object->getPosition().x > m_startPos.x) {
+            m_startPos = object->getPosition();
+            m_testMode = true;
+        }
+    } else if (frame.starts_with("rod_0")) {
+        //TODO: The pulse things
+    } else if (frame.starts_with("portal_0")) {
+        std::string backPortalTexture;
+
+        if (frame == "portal_01_front_001.png")
+            backPortalTexture = "portal_01_back_001.png";
+        else if (frame == "portal_02_front_001.png")
+            backPortalTexture = "portal_02_back_001.png";
+        else if (frame == "portal_03_front_001.png")
+            backPortalTexture = "portal_03_back_001.png";
+        else if (frame == "portal_04_front_001.png")
+            backPortalTexture = "portal_04_back_001.png";
+        else if (frame == "portal_05_front_001.png")
+            backPortalTexture = "portal_05_back_001.png";
+        else if (frame == "portal_06_front_001.png")
+            backPortalTexture = "portal_06_back_001.png";
+        else if (frame == "portal_07_front_001.png")
+            backPortalTexture = "portal_07_back_001.png";
+        else
+            backPortalTexture = "portal_01_back_001.png";
+
+        GameObject* back = m_objectPool.create(backPortalTexture);
+
+        if (back->getObjectKey() != 38) {
+            back->setObjectKey(38);
+            back->customSetup();
+        }
+
+        back->setStartPosition(object->getPosition());
+        back->setObjectParent(m_batchNode);
+        back->setObjectZ(-1);
+
+        back->setFlippedX(object->isFlippedX());
+        back->setFlippedY(object->isFlippedY());
+
+        back->setRotation(object->getRotation());
+        back->setStartRotation(object->getRotation());
+
+        addToSection(back);
+    }
+
+    return object;
+}
+
+void PlayScene::addToSection(GameObject* obj) {
+    auto section = std::max(sectionForPos(obj->getPosition()), 0);
+
+    ensureSectionCount(section + 1);
+
     m_sections[section].pushBack(obj);
     obj->setSectionIdx(section);
+
+    CollisionRect rect = toCollisionRect(obj->getObjectRect());
+    bool isHazard      = obj->getType() == GameObjectType::Hazard;
+
+    uint8_t flags = (obj->getIsDisabled() ? CollisionSection::FlagDisabled : 0) |
+                    (obj->getHasBeenActivated() ? CollisionSection::FlagActivated : 0) |
+                    (isHazard ? CollisionSection::FlagHazard : 0);
+    m_collisionGrid.insert(obj, rect, obj->getType(), flags);
+    m_newObjects.push_back(obj);
+
+    if (isHazard) {
+        m_hazardIndex.add(section, rect);
+    }
+}
+
+void PlayScene::ensureSectionCount(size_t count) {
+    if (m_sections.size() >= count) {
+        return;
+    }
+
+    m_sections.resize(count);
+    m_hazardIndex.resize(count);
+    m_sectionDescriptors.resize(count);
+    m_sectionMaterialized.resize(count, false);
+}
+
+void PlayScene::updateMaterializedSections(int previousSection, int nextSection) {
+    // Drop what scrolled out first so particles are back in the pool for the new sections.
+    for (int i = std::max(m_previousSection, 0); i < m_nextSection && i < m_sections.size(); i++) {
+        if ((i < previousSection || i >= nextSection) && m_sectionMaterialized[i]) {
+            releaseSection(i);
+        }
+    }
+
+    for (int i = std::max(previousSection, 0); i < nextSection && i < m_sections.size(); i++) {
+        if (!m_sectionMaterialized[i]) {
+            materializeSection(i);
+        }
+    }
+}
+
+void PlayScene::materializeSection(int section) {
+    TRACE_SCOPE("PlayScene::materializeSection");
+
+    m_sectionMaterialized[section] = true;
+
+    for (const ObjectDescriptor& desc : m_sectionDescriptors[section]) {
+        buildObject(desc);
+    }
+}
+
+void PlayScene::releaseSection(int section) {
+    m_sectionMaterialized[section] = false;
+
+    ax::Vector<GameObject*>& objects = m_sections[section];
+
+    // Spawn triggers are built up front and stay.
+    for (ssize_t i = static_cast<ssize_t>(objects.size()) - 1; i >= 0; i--) {
+        GameObject* object = objects.at(i);
+
+        if (object->getShouldSpawn()) {
+            continue;
+        }
+
+        m_collisionGrid.remove(object, toCollisionRect(object->getObjectRect()));
+        std::erase(m_newObjects, object);
+        m_objectPool.recycle(object);
+        objects.erase(i);
+    }
+
+    // Hazards are never spawn triggers, so none of them are left.
+    m_hazardIndex.clearSection(section);
+}
+
+void PlayScene::releaseAllSections() {
+    for (int i = 0; i < m_sections.size(); i++) {
+        if (m_sectionMaterialized[i]) {
+            releaseSection(i);
+        }
+    }
 }
 
 void PlayScene::resetLevel() {
     //TODO: this
 
     m_resetQueued = false;
+    m_refreshVisibility = true;
     m_activeEnterEffect = 1;
     stopActionByTag(0);
     stopActionByTag(1);
@@ -1298,6 +1625,15 @@ void PlayScene::resetLevel() {
         obj->setEnterEffect(1);
     }
 
+    m_collisionGrid.forEachCell([](auto& cell) {
+        cell.objects.clearActivated();
+    });
+
+    // Lazily built objects come back fresh when their sections are rebuilt.
+    if (m_lazyObjects) {
+        releaseAllSections();
+    }
+
     m_isFlipped = false;
     m_flipProgress = 0;
     m_backgroundXPosOffset = 0;
@@ -1326,7 +1662,20 @@ void PlayScene::resetLevel() {
     tintBackground(m_levelSettings->getStartBGColor(), 0);
     tintGround(m_levelSettings->getStartGColor(), 0);
 
-    m_lastPlayerPos = m_player->getPosition();
+    m_lastPlayerPos         = m_player->getPosition();
+    m_previousTickPlayerPos = m_lastPlayerPos;
+    flushQueuedInput();
+    m_physicsClock.reset();
+
+    // A button still held from the last attempt counts from the first tick.
+    m_recording.clear();
+    m_playbackCursor = 0;
+
+    if (m_playingReplay) {
+        m_player->releaseButton(PlayerButton::Unk);
+    } else if (m_player->getPhysics().getButtonPushed()) {
+        m_recording.record(0, true);
+    }
     updateCamera(0);
     updateVisibility();
 
@@ -1337,6 +1686,8 @@ void PlayScene::resetLevel() {
 }
 
 void PlayScene::checkSpawnObjects() {
+    FrameProfiler::Scope profile(m_profiler, FrameProfiler::Spawn);
+
     if (!m_spawnQueue.size()) {
         return;
     }
@@ -1349,14 +1700,12 @@ void PlayScene::checkSpawnObjects() {
     }
 }
 
-void PlayScene::applyEnterEffect(GameObject* object)
+void PlayScene::queueEnterEffect(GameObject* object, float opacityOffset, const ax::Size& winSize)
 {
     auto realPos = object->getRealPosition();
 
     if (!object->getEnterEffect())
     {
-        const ax::Vec2& winSize = ax::Director::getInstance()->getWinSize();
-
         object->setEnterEffect(m_activeEnterEffect);
 
         switch (m_activeEnterEffect) {
@@ -1404,91 +1753,48 @@ void PlayScene::applyEnterEffect(GameObject* object)
         }
     }
 
-    
-    float relativeMod = getRelativeMod(realPos, 60, 60, 0);
-
-    switch (object->getEnterEffect()) {
-        case 2:
-            if (!object->getUseAudioScale()) {
-                auto newScale = object->getStartScale() * relativeMod;
-                object->setScale(newScale.x, newScale.y);
-            }
-            object->setPosition(realPos);
-
-            break;
-        case 3:
-            if (!object->getUseAudioScale()) {
-                ax::Vec2 newScale = object->getStartScale() * (((1.0f - relativeMod) * 0.75) + 1.0);
-                object->setScale(newScale.x, newScale.y);
-            }
-            object->setPosition(realPos);
-
-            break;
-        case 4:
-            object->setPosition(realPos + ax::Vec2{0, (1.0f - relativeMod) * 100.0f});
-            if (!object->getUseAudioScale()) {
-                object->setScale(object->getStartScaleX(), object->getStartScaleY());
-            }
-
-            break;
-        case 5:
-            object->setPosition(realPos + ax::Vec2{0, (1.0f - relativeMod) * -100.0f});
-            if (!object->getUseAudioScale()) {
-                object->setScale(object->getStartScaleX(), object->getStartScaleY());
-            }
+    bool effectChanged = object->takeEnterEffectChanged();
+    int slot           = object->getEnterEffectSlot();
 
-            break;
-        case 6:
-            object->setPosition(realPos + ax::Vec2{(1.0f - relativeMod) * -100.0f, 0});
-            if (!object->getUseAudioScale()) {
-                object->setScale(object->getStartScaleX(), object->getStartScaleY());
-            }
+    if (slot < 0) {
+        slot = static_cast<int>(m_enterEffectBatch.add(
+            realPos.x, opacityOffset, enter_effect::coefficients(object->getEnterEffect(), object->getEnterAngle())));
+        object->setEnterEffectSlot(slot);
+        m_enterEffectObjects.push_back(object);
+    } else {
+        m_enterEffectBatch.opacityOffset[slot] = opacityOffset;
 
-            break;
-        case 7:
-            object->setPosition(realPos + ax::Vec2{(1.0f - relativeMod) * 100.0f, 0});
-            if (!object->getUseAudioScale()) {
-                object->setScale(object->getStartScaleX(), object->getStartScaleY());
-            }
+        if (effectChanged) {
+            m_enterEffectBatch.setCoefficients(
+                slot, enter_effect::coefficients(object->getEnterEffect(), object->getEnterAngle()));
+        }
+    }
 
-            break;
-        case 8:
-        case 9:
-        case 10:
-        case 11:
-        case 12: {
-            float angle = (object->getEnterAngle() - 90.0) * 0.017453;
-            auto ccpForAngle = [](float angle) {
-                return ax::Vec2{cos(angle), sin(angle)}; };
-            ax::Vec2 point       = ccpForAngle(angle);
-
-            ax::Vec2 newPos = ax::Vec2{
-                ((1.0f - relativeMod) * 100.0f) * point.x,
-                ((1.0f - relativeMod) * 100.0f) * point.y}
-                + realPos;
-            
-            object->setPosition(newPos);
-
-            if (!object->getUseAudioScale()) {
-                object->setScale(object->getStartScaleX(), object->getStartScaleY());
-            }
+    m_enterEffectQueue.push_back(object);
+}
 
-            break;
-        }
-        default:
-            object->setPosition(realPos);
+void PlayScene::removeEnterEffect(GameObject* object) {
+    int slot = object->getEnterEffectSlot();
 
-            if (!object->getUseAudioScale()) {
-                object->setScale(object->getStartScaleX(), object->getStartScaleY());
-            }
+    if (slot < 0) {
+        return;
     }
 
-    if (relativeMod == 1 || relativeMod == 0) {
-        object->setEnterEffect(0);
-    }
+    m_enterEffectBatch.remove(slot);
+    m_enterEffectObjects[slot] = m_enterEffectObjects.back();
+    m_enterEffectObjects[slot]->setEnterEffectSlot(slot);
+    m_enterEffectObjects.pop_back();
+    object->setEnterEffectSlot(-1);
 }
 
 void PlayScene::startGame() {
+    // Picked up again by updateLevelLoading once the start of the level is built.
+    if (m_levelLoader && !m_levelLoader->isStartWindowReady()) {
+        m_startGameQueued = true;
+        return;
+    }
+
+    m_gameStarted = true;
     this->scheduleUpdate();
 
     m_cleanReset = true;
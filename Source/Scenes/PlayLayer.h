@@ -6,6 +6,22 @@
 #include <Inspector/Inspector.h>
 
 #include "Objects/GameObject.h" // not forward declared because of ax::Vector
+#include "Objects/GameObjectPool.h"
+#include "Objects/GlowBatchNode.h"
+#include "Objects/ObjectBatchNode.h"
+#include "Objects/CollisionSection.h"
+#include "Objects/HazardIndex.h"
+#include "Objects/ObjectCollision.h"
+#include "Objects/ParticlePool.h"
+#include "Objects/SpatialGrid.h"
+#include "Managers/GameManager.h"
+#include "Utils/EnterEffect.inl.h"
+#include "Utils/FixedTimestep.inl.h"
+#include "Utils/FrameProfiler.inl.h"
+#include "Utils/ReplayFormat.inl.h"
+
+#include <chrono>
+#include <memory>
 
 namespace ax {
     class ParticleSystemQuad;
@@ -16,11 +32,14 @@ namespace ax {
 }
 
 class Level;
+class LevelLoader;
 class LevelSettings;
 class GroundLayer;
+class InputThread;
 class PlayerObject;
+class ProfilerOverlay;
 
-class PlayScene : public ax::Scene, public ax::ActionTweenDelegate {
+class PlayScene : public ax::Scene, public ax::ActionTweenDelegate, private ObjectCollision<GameObject*>::Host {
 public:
     ~PlayScene();
 
@@ -35,15 +54,21 @@ public:
     void tintBackground(ax::Color3B color, float duration);
     void tintGround(ax::Color3B color, float duration);
 
-    const std::string getParticleKey(
+    /**
+     * Id of a particle kind for `createParticle`/`claimParticle`/`unclaimParticle`, see `ParticlePool`.
+     */
+    ParticlePool::Id internParticle(
         int type, const char* plist, int unk, ax::ParticleSystem::PositionType positionType);
-    const std::string getParticleKey2(const std::string key);
 
-    ax::ParticleSystemQuad* createParticle(
-        int type, const char* plist, int unk, ax::ParticleSystem::PositionType positionType);
+    ax::ParticleSystemQuad* createParticle(ParticlePool::Id id);
     
-    ax::ParticleSystemQuad* claimParticle(std::string key);
-    void unclaimParticle(const char* key, ax::ParticleSystemQuad* particleSystem);
+    ax::ParticleSystemQuad* claimParticle(ParticlePool::Id id, bool transformed);
+    void unclaimParticle(ParticlePool::Id id, ax::ParticleSystemQuad* particleSystem);
+
+    /**
+     * Drops the `m_enterEffectBatch` entry of a deactivated object.
+     */
+    void removeEnterEffect(GameObject* object);
 
     void destroyPlayer();
     void delayedResetLevel();
@@ -56,10 +81,14 @@ public:
         return m_gameLayer;
     }
 
-    ax::SpriteBatchNode* getBatchNodeAdd() const {
+    ObjectBatchNode* getBatchNodeAdd() const {
         return m_additiveBatchNode;
     }
 
+    GlowBatchNode* getGlowBatchNode() const {
+        return m_glowBatchNode;
+    }
+
     ax::DrawNode* getDrawNode() const {
         return m_debugDrawNode;
     }
@@ -70,8 +99,33 @@ public:
 private:
     void setupKeybinds();
     void setupTouchControls();
+    void pushButton();
+    void releaseButton();
+    void scheduleQueuedInput();
+    void applyQueuedInput(uint64_t tick);
+    void flushQueuedInput();
+    void applyReplayInput(uint64_t tick);
+    void saveReplay();
 private:
-    void checkCollisions(float);
+    void checkCollisions();
+    CollisionRect sweepStartRect(const CollisionRect& playerRect) const;
+
+    // `ObjectCollision::Host`
+    CollisionRect getPlayerRect() const override;
+    bool getGravityFlipped() const override;
+    bool isObjectActivated(GameObject* object) const override;
+    void setObjectActivated(GameObject* object) override;
+    float getObjectRotation(GameObject* object) const override;
+    bool isObjectFlippedY(GameObject* object) const override;
+    void onGravityPortal(GameObject* portal, bool flip) override;
+    void onShipPortal(GameObject* portal) override;
+    void onBallPortal(GameObject* portal) override;
+    void onCubePortal(GameObject* portal) override;
+    void onMirrorPortal(GameObject* portal, bool mirrored) override;
+    void onPad(GameObject* pad, float force, bool gravityFlipped) override;
+    void onOrb(GameObject* orb, GameObjectType type) override;
+    void onBlock(GameObject* block, const CollisionRect& rect) override;
+
     int sectionForPos(ax::Vec2);
     void switchToFlyMode(GameObject* portal, bool instantCamera);
     void switchToRollMode(GameObject* object, bool instantCamera);
@@ -83,14 +137,21 @@ private:
     void updateVisibility();
     void toggleFlipped(bool,bool);
     bool isFlipping() const;
-    float getRelativeMod(ax::Vec2, float, float, float);
     void animateInFlyGround(bool);
     void animateOutFlyGround(bool);
-    void createObjectsFromSetup(std::string);
+    void updateLevelLoading(float);
+    void finishLevelLoading();
+    void createObjectFromDescriptor(const ObjectDescriptor&);
+    GameObject* buildObject(const ObjectDescriptor&);
     void addToSection(GameObject*);
+    void ensureSectionCount(size_t);
+    void updateMaterializedSections(int previousSection, int nextSection);
+    void materializeSection(int);
+    void releaseSection(int);
+    void releaseAllSections();
     void resetLevel();
     void checkSpawnObjects();
-    void applyEnterEffect(GameObject*);
+    void queueEnterEffect(GameObject*, float opacityOffset, const ax::Size& winSize);
     void startGame();
     void playGravityEffect(bool);
     void animateInRollGround(bool instant);
@@ -99,7 +160,7 @@ private:
 private:
 	int m_activeEnterEffect;
 
-    std::unordered_map<std::string, ax::Vector<ax::ParticleSystemQuad*>> m_particleDictionary;
+    ParticlePool m_particlePool; ///< Replaces `m_particleDictionary`, which was keyed by formatted strings.
 
     LevelSettings* m_levelSettings;
     ax::Color3B m_activeBGColor;
@@ -146,11 +207,43 @@ private:
     ax::Layer* m_gameLayer;
 
     std::vector<ax::SpriteBatchNode*> m_batchNodes;
-    ax::SpriteBatchNode* m_additiveBatchNode;
-    ax::SpriteBatchNode* m_batchNode;
+    ObjectBatchNode* m_additiveBatchNode;
+    GlowBatchNode* m_glowBatchNode; ///< Every object's glow, see `GlowBatchNode`.
+    ObjectBatchNode* m_batchNode;
 
     std::vector<ax::Vector<GameObject*>> m_sections; ///< Offset (1.3): 0x184
-    ax::Vector<GameObject*> m_hazards; ///< Offset (1.3): 0x188
+    SpatialGrid<GameObject*> m_collisionGrid; ///< Every placed object by (x, y), used for collisions and visibility.
+    SpatialGrid<GameObject*>::CellRange m_visibleCells; ///< Cells activated by the last `updateVisibility`.
+    SpatialGrid<GameObject*>::CellRange m_leftBand;     ///< Cells of `m_visibleCells` the left screen edge fades went over.
+    SpatialGrid<GameObject*>::CellRange m_rightBand;    ///< Same for the right screen edge.
+    std::vector<GameObject*> m_newObjects;              ///< Added to the grid since the last `updateVisibility`.
+    enter_effect::Batch m_enterEffectBatch;            ///< Fade and enter effect inputs of every active object.
+    std::vector<GameObject*> m_enterEffectObjects;     ///< Object of every entry in `m_enterEffectBatch`.
+    std::vector<GameObject*> m_enterEffectQueue;       ///< Objects `updateVisibility` updates this frame.
+    bool m_refreshVisibility = true; ///< Next `updateVisibility` walks every visible object, not just the changes.
+    bool m_wasFlipping       = false;
+
+    bool m_lazyObjects = false; ///< See `GameManager::getLazyObjects`.
+    std::vector<std::vector<ObjectDescriptor>> m_sectionDescriptors; ///< Lazy mode: every object of a section, built or not.
+    std::vector<bool> m_sectionMaterialized; ///< Lazy mode: whether the objects of a section currently exist.
+    GameObjectPool m_objectPool; ///< Lazy mode: objects of released sections, reused by the next sections.
+    HazardIndex m_hazardIndex; ///< Replaces `m_hazards` (Offset (1.3): 0x188), which was refilled on every substep.
+    ObjectCollision<GameObject*> m_objectCollision; ///< Runs `checkCollisions` against `m_collisionGrid` and `m_hazardIndex`.
+
+    CollisionMode m_collisionMode = CollisionMode::Substeps; ///< See `GameManager::getCollisionMode`.
+    FixedTimestep m_physicsClock; ///< Ticks the player and collisions independently of the frame rate.
+    struct QueuedInput {
+        std::chrono::steady_clock::time_point time;
+        bool press;
+    };
+
+    std::vector<QueuedInput> m_inputQueue; ///< Input since the last frame, with the time it arrived.
+    std::unique_ptr<InputThread> m_inputThread; ///< Takes over the jump key when enabled, see `GameManager::getInputThread`.
+    std::vector<replay_format::Event> m_scheduledInput; ///< Queued input placed on the tick it arrived at.
+    replay_format::Replay m_recording; ///< Input of the current attempt, see `saveReplay`.
+    replay_format::Replay m_playback;  ///< Played instead of input while `m_playingReplay`.
+    size_t m_playbackCursor = 0;
+    bool m_playingReplay = false;
     ax::Vector<GameObject*> m_objects; ///< Offset (1.3): 0x198
     ax::Vector<GameObject*> m_spawnObjects; ///< Offset (1.3): 0x190
     ax::Vector<GameObject*> m_spawnQueue; ///< All queued objects to be spawned. See `resetLevel` and `checkSpawnObjects`.
@@ -200,6 +293,7 @@ private:
     PlayerObject* m_player = nullptr;
     ax::SpriteBatchNode* m_playerBatchNode = nullptr;
     ax::Vec2 m_lastPlayerPos = ax::Vec2::ZERO;
+    ax::Vec2 m_previousTickPlayerPos = ax::Vec2::ZERO; ///< Player position one tick before `m_lastPlayerPos`, for interpolation.
     ax::Vec2 m_startPos = {0, 105};
 
     bool m_onLevelEndAnimation = false;
@@ -208,8 +302,16 @@ private:
 
     Level* m_level = nullptr;
 
+    std::unique_ptr<LevelLoader> m_levelLoader; ///< Alive while the level is still being built.
+    bool m_levelInfoApplied = false;
+    bool m_startGameQueued = false;
+    bool m_gameStarted = false;
+
     bool m_testMode = true;
 
     std::vector<GameObject*> m_debugDrawObjects;
     ax::DrawNode* m_debugDrawNode = nullptr;
+
+    FrameProfiler m_profiler; ///< Off until the overlay is opened.
+    ProfilerOverlay* m_profilerOverlay = nullptr;
 };
@@ -0,0 +1,159 @@
+#include "ProfilerOverlay.h"
+
+#include <2d/DrawNode.h>
+#include <2d/Label.h>
+#include <base/Director.h>
+#include <base/EventDispatcher.h>
+#include <base/EventListenerCustom.h>
+
+#include <algorithm>
+#include <cstdio>
+
+static const ax::Color4F PHASE_COLORS[FrameProfiler::PhaseCount] = {
+    {0.30f, 0.60f, 1.00f, 1}, // physics
+    {1.00f, 0.35f, 0.30f, 1}, // collisions
+    {0.95f, 0.85f, 0.25f, 1}, // camera
+    {0.40f, 0.90f, 0.45f, 1}, // visibility
+    {0.80f, 0.45f, 0.95f, 1}, // spawn
+    {1.00f, 0.60f, 0.20f, 1}, // render
+};
+
+static const ax::Color4F OTHER_COLOR = {0.55f, 0.55f, 0.55f, 1};
+
+ProfilerOverlay* ProfilerOverlay::create(FrameProfiler* profiler) {
+    auto p = new ProfilerOverlay();
+
+    if (!p->init(profiler)) {
+        delete p;
+        return nullptr;
+    }
+
+    p->autorelease();
+    return p;
+}
+
+bool ProfilerOverlay::init(FrameProfiler* profiler) {
+    if (!ax::Node::init()) {
+        return false;
+    }
+
+    m_profiler = profiler;
+
+    const ax::Size winSize = ax::Director::getInstance()->getWinSize();
+
+    m_graph = ax::DrawNode::create();
+    m_graph->setPosition({4, winSize.height - GRAPH_HEIGHT - 4});
+    this->addChild(m_graph);
+
+    createLabel("               p50      p99      max (ms)", 0);
+    m_frameLabel = createLabel("frame", 1);
+
+    for (int phase = 0; phase < FrameProfiler::PhaseCount; phase++) {
+        m_phaseLabels[phase] = createLabel(FrameProfiler::getPhaseName(static_cast<FrameProfiler::Phase>(phase)),
+                                           static_cast<float>(phase + 2));
+        m_phaseLabels[phase]->setTextColor(ax::Color4B(PHASE_COLORS[phase]));
+    }
+
+    return true;
+}
+
+ax::Label* ProfilerOverlay::createLabel(std::string_view text, float line) {
+    const ax::Size winSize = ax::Director::getInstance()->getWinSize();
+
+    ax::Label* label = ax::Label::createWithSystemFont(text, "Courier New", 9);
+    label->setAnchorPoint({0, 1});
+    label->setPosition({FrameProfiler::SAMPLE_COUNT + 12.0f, winSize.height - 4 - line * LINE_HEIGHT});
+    this->addChild(label);
+
+    return label;
+}
+
+void ProfilerOverlay::onEnter() {
+    ax::Node::onEnter();
+
+    ax::EventDispatcher* dispatcher = ax::Director::getInstance()->getEventDispatcher();
+
+    m_beforeDrawListener = dispatcher->addCustomEventListener(ax::Director::EVENT_BEFORE_DRAW, [this](ax::EventCustom*) {
+        m_drawStart = FrameProfiler::clock::now();
+    });
+
+    m_afterDrawListener = dispatcher->addCustomEventListener(ax::Director::EVENT_AFTER_DRAW, [this](ax::EventCustom*) {
+        if (m_profiler->isEnabled()) {
+            m_profiler->add(FrameProfiler::Render, FrameProfiler::clock::now() - m_drawStart);
+        }
+    });
+
+    scheduleUpdate();
+}
+
+void ProfilerOverlay::onExit() {
+    ax::EventDispatcher* dispatcher = ax::Director::getInstance()->getEventDispatcher();
+    dispatcher->removeEventListener(m_beforeDrawListener);
+    dispatcher->removeEventListener(m_afterDrawListener);
+    m_beforeDrawListener = nullptr;
+    m_afterDrawListener  = nullptr;
+
+    ax::Node::onExit();
+}
+
+void ProfilerOverlay::update(float) {
+    if (!isVisible() || !m_profiler->isEnabled()) {
+        return;
+    }
+
+    drawGraph();
+
+    if (--m_framesUntilText <= 0) {
+        m_framesUntilText = TEXT_UPDATE_EVERY;
+        updateText();
+    }
+}
+
+void ProfilerOverlay::drawGraph() {
+    constexpr float scale = GRAPH_HEIGHT / GRAPH_MAX_MS;
+    constexpr float width = static_cast<float>(FrameProfiler::SAMPLE_COUNT);
+
+    m_graph->clear();
+    m_graph->drawSolidRect({0, 0}, {width, GRAPH_HEIGHT}, {0, 0, 0, 0.5f});
+
+    // Newest frame on the right.
+    for (size_t age = 0; age < m_profiler->getSampleCount(); age++) {
+        const FrameProfiler::Sample& sample = m_profiler->getSample(age);
+        const float x = width - 0.5f - static_cast<float>(age);
+
+        float y = 0;
+
+        for (int phase = 0; phase < FrameProfiler::PhaseCount; phase++) {
+            float height = std::min(sample.phaseMs[phase] * scale, GRAPH_HEIGHT - y);
+
+            if (height > 0) {
+                m_graph->drawLine({x, y}, {x, y + height}, PHASE_COLORS[phase]);
+                y += height;
+            }
+        }
+
+        float frameHeight = std::min(sample.frameMs * scale, GRAPH_HEIGHT);
+
+        if (frameHeight > y) {
+            m_graph->drawLine({x, y}, {x, frameHeight}, OTHER_COLOR);
+        }
+    }
+
+    const float frame60 = 1000.0f / 60 * scale;
+    m_graph->drawLine({0, frame60}, {width, frame60}, {1, 1, 1, 0.6f});
+}
+
+void ProfilerOverlay::updateText() {
+    auto setStats = [](ax::Label* label, const char* name, const FrameProfiler::Stats& stats) {
+        char text[64];
+        std::snprintf(text, sizeof(text), "%-10s %7.2f  %7.2f  %7.2f", name, stats.p50, stats.p99, stats.max);
+        label->setString(text);
+    };
+
+    setStats(m_frameLabel, "frame", m_profiler->getFrameStats());
+
+    for (int phase = 0; phase < FrameProfiler::PhaseCount; phase++) {
+        auto p = static_cast<FrameProfiler::Phase>(phase);
+        setStats(m_phaseLabels[phase], FrameProfiler::getPhaseName(p), m_profiler->getPhaseStats(p));
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <2d/Node.h>
+
+#include <string_view>
+
+#include "Utils/FrameProfiler.inl.h"
+
+namespace ax {
+    class DrawNode;
+    class EventListenerCustom;
+    class Label;
+}
+
+/**
+ * Screen-space graph of the last `FrameProfiler::SAMPLE_COUNT` frames, one stacked column per frame
+ * and phase, with p50/p99/max per phase next to it. Also times the renderer for the profiler through
+ * the director's draw events, so it has to stay in the scene while profiling.
+ */
+class ProfilerOverlay : public ax::Node {
+public:
+    static constexpr float GRAPH_HEIGHT    = 100.0f;
+    static constexpr float GRAPH_MAX_MS    = 100.0f / 3.0f; ///< Two 60 Hz frames.
+    static constexpr int TEXT_UPDATE_EVERY = 15;            ///< Frames, the numbers are unreadable otherwise.
+    static constexpr float LINE_HEIGHT     = 11.0f;
+
+    static ProfilerOverlay* create(FrameProfiler* profiler);
+    bool init(FrameProfiler* profiler);
+
+    void onEnter() override;
+    void onExit() override;
+    void update(float dt) override;
+
+private:
+    ax::Label* createLabel(std::string_view text, float line);
+    void drawGraph();
+    void updateText();
+
+private:
+    FrameProfiler* m_profiler = nullptr;
+    ax::DrawNode* m_graph     = nullptr;
+    ax::Label* m_frameLabel   = nullptr;
+    ax::Label* m_phaseLabels[FrameProfiler::PhaseCount] {}; ///< In the phase's graph color.
+    int m_framesUntilText     = 0;
+
+    ax::EventListenerCustom* m_beforeDrawListener = nullptr;
+    ax::EventListenerCustom* m_afterDrawListener  = nullptr;
+    FrameProfiler::clock::time_point m_drawStart;
+};
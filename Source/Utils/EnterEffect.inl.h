@@ -0,0 +1,330 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define TOMBSTONE_ENTER_EFFECT_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#    include <arm_neon.h>
+#    define TOMBSTONE_ENTER_EFFECT_NEON 1
+#endif
+
+/**
+ * Edge fades and enter effects of the objects near the screen edges, without the nodes.
+ *
+ * `PlayScene` keeps the inputs of every active object in a `Batch` and `run`s them all at once per
+ * frame. `relative_mod` and `transform` are the same math for a single object.
+ */
+namespace enter_effect {
+    /**
+     * How far an object at `x` has made it onto the screen, from 0 (outside) to 1 (fully in).
+     * `rightFade` and `leftFade` are the widths of the fade on either side of the screen center,
+     * `offset` moves the object's edge towards the center.
+     */
+    inline float relative_mod(float x, float cameraX, float halfScreenWidth, float rightFade, float leftFade,
+                              float offset) {
+        float fade, distance;
+
+        if (x <= (cameraX + halfScreenWidth)) {
+            fade     = leftFade;
+            distance = ((cameraX + halfScreenWidth) - x) - offset;
+        } else {
+            fade     = rightFade;
+            distance = ((x - offset) - cameraX) - halfScreenWidth;
+        }
+
+        if (fade < 1.0) {
+            fade = 1.0;
+        }
+
+        float res = (halfScreenWidth - distance) / fade;
+        return std::clamp(res, 0.0f, 1.0f);
+    }
+
+    /**
+     * Where the object is drawn relative to its real position and what its start scale is multiplied
+     * with, for enter effect `effect` at `relativeMod`.
+     */
+    struct Transform {
+        float offsetX = 0;
+        float offsetY = 0;
+        float scale   = 1;
+    };
+
+    /**
+     * An enter effect as a linear function of `k = 1 - relativeMod`, so every effect is the same
+     * few multiply-adds:
+     *
+     *     offset = k * (dirX, dirY)
+     *     scale  = relativeMod * scaleMod + k * scaleFade + scaleBase
+     */
+    struct Coefficients {
+        float dirX      = 0;
+        float dirY      = 0;
+        float scaleMod  = 0;
+        float scaleFade = 0;
+        float scaleBase = 1;
+    };
+
+    inline Coefficients coefficients(int effect, float enterAngle) {
+        Coefficients result;
+
+        switch (effect) {
+            case 2:
+                result.scaleMod  = 1;
+                result.scaleBase = 0;
+                break;
+            case 3:
+                result.scaleFade = 0.75f;
+                break;
+            case 4:
+                result.dirY = 100;
+                break;
+            case 5:
+                result.dirY = -100;
+                break;
+            case 6:
+                result.dirX = -100;
+                break;
+            case 7:
+                result.dirX = 100;
+                break;
+            case 8:
+            case 9:
+            case 10:
+            case 11:
+            case 12: {
+                float angle = (enterAngle - 90.0) * 0.017453;
+
+                result.dirX = 100.0f * std::cos(angle);
+                result.dirY = 100.0f * std::sin(angle);
+                break;
+            }
+            default:
+                break;
+        }
+
+        return result;
+    }
+
+    inline Transform apply(const Coefficients& coefficients, float relativeMod) {
+        float k = 1.0f - relativeMod;
+
+        return {k * coefficients.dirX, k * coefficients.dirY,
+                relativeMod * coefficients.scaleMod + k * coefficients.scaleFade + coefficients.scaleBase};
+    }
+
+    inline Transform transform(int effect, float relativeMod, float enterAngle) {
+        return apply(coefficients(effect, enterAngle), relativeMod);
+    }
+
+    /**
+     * Fade and enter effect inputs of every active object, as arrays. An object `add`s itself once
+     * when it becomes active and keeps its entry until it is `remove`d again, so a frame only
+     * touches the inputs that changed before `run` fills in the outputs of all entries.
+     */
+    struct Batch {
+        // Input
+        std::vector<float> x;             ///< Real X position.
+        std::vector<float> opacityOffset; ///< `offset` of the opacity fade.
+        std::vector<float> dirX, dirY, scaleMod, scaleFade, scaleBase;
+
+        // Output
+        std::vector<float> opacity; ///< 0 to 255.
+        std::vector<float> relativeMod;
+        std::vector<float> offsetX, offsetY, scale;
+
+        /**
+         * The arrays are only ever grown, `size()` of their entries are in use.
+         */
+        size_t size() const { return count; }
+
+        void clear() { count = 0; }
+
+        /**
+         * Index of the new entry. Its outputs are only valid after the next `run`.
+         */
+        size_t add(float objectX, float objectOpacityOffset, const Coefficients& coefficients) {
+            if (count == x.size()) {
+                grow();
+            }
+
+            x[count]             = objectX;
+            opacityOffset[count] = objectOpacityOffset;
+            setCoefficients(count, coefficients);
+
+            return count++;
+        }
+
+        void setCoefficients(size_t i, const Coefficients& coefficients) {
+            dirX[i]      = coefficients.dirX;
+            dirY[i]      = coefficients.dirY;
+            scaleMod[i]  = coefficients.scaleMod;
+            scaleFade[i] = coefficients.scaleFade;
+            scaleBase[i] = coefficients.scaleBase;
+        }
+
+        /**
+         * Moves the last entry, outputs included, into `i`. The owner of that entry has to be told.
+         */
+        void remove(size_t i) {
+            count--;
+
+            for (std::vector<float>* array : arrays()) {
+                (*array)[i] = (*array)[count];
+            }
+        }
+
+    private:
+        std::array<std::vector<float>*, 12> arrays() {
+            return {&x, &opacityOffset, &dirX, &dirY, &scaleMod, &scaleFade, &scaleBase,
+                    &opacity, &relativeMod, &offsetX, &offsetY, &scale};
+        }
+
+        void grow() {
+            size_t capacity = std::max<size_t>(x.size() * 2, 256);
+
+            for (std::vector<float>* array : arrays()) {
+                array->resize(capacity);
+            }
+        }
+
+        size_t count = 0;
+    };
+
+    constexpr float OPACITY_FADE = 70; ///< Both sides.
+    constexpr float EFFECT_FADE  = 60; ///< Both sides, no offset.
+
+    /**
+     * `relative_mod` and `apply` for the objects from `first` on, one at a time.
+     */
+    inline void run_scalar(Batch& batch, size_t first, float cameraX, float halfScreenWidth) {
+        for (size_t i = first; i < batch.size(); i++) {
+            float mod = relative_mod(batch.x[i], cameraX, halfScreenWidth, EFFECT_FADE, EFFECT_FADE, 0);
+            Transform transform =
+                apply({batch.dirX[i], batch.dirY[i], batch.scaleMod[i], batch.scaleFade[i], batch.scaleBase[i]}, mod);
+
+            batch.opacity[i] = relative_mod(batch.x[i], cameraX, halfScreenWidth, OPACITY_FADE, OPACITY_FADE,
+                                            batch.opacityOffset[i]) * 255;
+            batch.relativeMod[i] = mod;
+            batch.offsetX[i]     = transform.offsetX;
+            batch.offsetY[i]     = transform.offsetY;
+            batch.scale[i]       = transform.scale;
+        }
+    }
+
+    /**
+     * Fills the outputs of `batch` for a camera at `cameraX`. Same results as `run_scalar`, four
+     * objects per step with SSE2 or NEON.
+     */
+    inline void run(Batch& batch, float cameraX, float halfScreenWidth) {
+        const size_t count = batch.size();
+        size_t i = 0;
+
+#if defined(TOMBSTONE_ENTER_EFFECT_SSE)
+        const __m128 center      = _mm_set1_ps(cameraX + halfScreenWidth);
+        const __m128 camera      = _mm_set1_ps(cameraX);
+        const __m128 halfWidth   = _mm_set1_ps(halfScreenWidth);
+        const __m128 zero        = _mm_setzero_ps();
+        const __m128 one         = _mm_set1_ps(1);
+        const __m128 opacityMax  = _mm_set1_ps(255);
+        const __m128 opacityFade = _mm_set1_ps(OPACITY_FADE);
+        const __m128 effectFade  = _mm_set1_ps(EFFECT_FADE);
+
+        // `relative_mod`, both branches, then picks one per lane.
+        auto relativeMod = [&](__m128 x, __m128 offset, __m128 fade) {
+            __m128 left     = _mm_sub_ps(_mm_sub_ps(center, x), offset);
+            __m128 right    = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(x, offset), camera), halfWidth);
+            __m128 isLeft   = _mm_cmple_ps(x, center);
+            __m128 distance = _mm_or_ps(_mm_and_ps(isLeft, left), _mm_andnot_ps(isLeft, right));
+
+            return _mm_min_ps(_mm_max_ps(_mm_div_ps(_mm_sub_ps(halfWidth, distance), fade), zero), one);
+        };
+
+        for (; i + 4 <= count; i += 4) {
+            __m128 x   = _mm_loadu_ps(batch.x.data() + i);
+            __m128 mod = relativeMod(x, zero, effectFade);
+            __m128 k   = _mm_sub_ps(one, mod);
+
+            __m128 opacity = relativeMod(x, _mm_loadu_ps(batch.opacityOffset.data() + i), opacityFade);
+            __m128 scale   = _mm_add_ps(_mm_add_ps(_mm_mul_ps(mod, _mm_loadu_ps(batch.scaleMod.data() + i)),
+                                                   _mm_mul_ps(k, _mm_loadu_ps(batch.scaleFade.data() + i))),
+                                        _mm_loadu_ps(batch.scaleBase.data() + i));
+
+            _mm_storeu_ps(batch.opacity.data() + i, _mm_mul_ps(opacity, opacityMax));
+            _mm_storeu_ps(batch.relativeMod.data() + i, mod);
+            _mm_storeu_ps(batch.offsetX.data() + i, _mm_mul_ps(k, _mm_loadu_ps(batch.dirX.data() + i)));
+            _mm_storeu_ps(batch.offsetY.data() + i, _mm_mul_ps(k, _mm_loadu_ps(batch.dirY.data() + i)));
+            _mm_storeu_ps(batch.scale.data() + i, scale);
+        }
+#elif defined(TOMBSTONE_ENTER_EFFECT_NEON)
+        const float32x4_t center      = vdupq_n_f32(cameraX + halfScreenWidth);
+        const float32x4_t camera      = vdupq_n_f32(cameraX);
+        const float32x4_t halfWidth   = vdupq_n_f32(halfScreenWidth);
+        const float32x4_t zero        = vdupq_n_f32(0);
+        const float32x4_t one         = vdupq_n_f32(1);
+        const float32x4_t opacityMax  = vdupq_n_f32(255);
+        const float32x4_t opacityFade = vdupq_n_f32(OPACITY_FADE);
+        const float32x4_t effectFade  = vdupq_n_f32(EFFECT_FADE);
+
+        // ARMv7 has no vector divide, and a reciprocal estimate would round differently from `run_scalar`.
+        auto divide = [](float32x4_t a, float32x4_t b) {
+#    if defined(__aarch64__) || defined(_M_ARM64)
+            return vdivq_f32(a, b);
+#    else
+            float lanes[4], divisors[4];
+            vst1q_f32(lanes, a);
+            vst1q_f32(divisors, b);
+
+            for (int lane = 0; lane < 4; lane++) {
+                lanes[lane] /= divisors[lane];
+            }
+
+            return vld1q_f32(lanes);
+#    endif
+        };
+
+        auto relativeMod = [&](float32x4_t x, float32x4_t offset, float32x4_t fade) {
+            float32x4_t left     = vsubq_f32(vsubq_f32(center, x), offset);
+            float32x4_t right    = vsubq_f32(vsubq_f32(vsubq_f32(x, offset), camera), halfWidth);
+            float32x4_t distance = vbslq_f32(vcleq_f32(x, center), left, right);
+
+            return vminq_f32(vmaxq_f32(divide(vsubq_f32(halfWidth, distance), fade), zero), one);
+        };
+
+        for (; i + 4 <= count; i += 4) {
+            float32x4_t x   = vld1q_f32(batch.x.data() + i);
+            float32x4_t mod = relativeMod(x, zero, effectFade);
+            float32x4_t k   = vsubq_f32(one, mod);
+
+            float32x4_t opacity = relativeMod(x, vld1q_f32(batch.opacityOffset.data() + i), opacityFade);
+            float32x4_t scale   = vaddq_f32(vaddq_f32(vmulq_f32(mod, vld1q_f32(batch.scaleMod.data() + i)),
+                                                      vmulq_f32(k, vld1q_f32(batch.scaleFade.data() + i))),
+                                            vld1q_f32(batch.scaleBase.data() + i));
+
+            vst1q_f32(batch.opacity.data() + i, vmulq_f32(opacity, opacityMax));
+            vst1q_f32(batch.relativeMod.data() + i, mod);
+            vst1q_f32(batch.offsetX.data() + i, vmulq_f32(k, vld1q_f32(batch.dirX.data() + i)));
+            vst1q_f32(batch.offsetY.data() + i, vmulq_f32(k, vld1q_f32(batch.dirY.data() + i)));
+            vst1q_f32(batch.scale.data() + i, scale);
+        }
+#endif
+
+        run_scalar(batch, i, cameraX, halfScreenWidth);
+    }
+
+    constexpr const char* kernel_name() {
+#if defined(TOMBSTONE_ENTER_EFFECT_SSE)
+        return "sse2";
+#elif defined(TOMBSTONE_ENTER_EFFECT_NEON)
+        return "neon";
+#else
+        return "scalar";
+#endif
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+/**
+ * Fixed-rate physics clock. Every rendered frame adds the time it took, the simulation then runs one
+ * tick of exactly `1 / tickRate` seconds per `step()`. A run only depends on the inputs and the tick
+ * they landed on, not on the display's refresh rate, and the physics cost per second stays the same.
+ *
+ * More than `MAX_TICKS_PER_FRAME` ticks of backlog (a loading hitch, a breakpoint) is dropped instead
+ * of being caught up all at once.
+ */
+class FixedTimestep {
+public:
+    static constexpr int SUBSTEP_TICK_RATE   = 240; ///< `CollisionMode::Substeps`, four ticks per 60 Hz frame.
+    static constexpr int SWEPT_TICK_RATE     = 60;  ///< `CollisionMode::Swept`, the sweep covers a whole frame.
+    static constexpr int MAX_TICKS_PER_FRAME = 60;
+
+    explicit FixedTimestep(int tickRate = SUBSTEP_TICK_RATE) {
+        setTickRate(tickRate);
+    }
+
+    /**
+     * Also resets the clock.
+     */
+    void setTickRate(int tickRate) {
+        m_tickRate    = std::max(tickRate, 1);
+        m_tickSeconds = 1.0 / m_tickRate;
+        reset();
+    }
+
+    int getTickRate() const { return m_tickRate; }
+    double getTickSeconds() const { return m_tickSeconds; }
+
+    /**
+     * One tick in 60 Hz frames, the unit `PlayerObject::update` and `PlayScene::checkCollisions` take.
+     */
+    float getTickDelta() const { return 60.0f / m_tickRate; }
+
+    /**
+     * Ticks per 60 Hz frame, at least 1.
+     */
+    int getTicksPerFrame() const { return std::max(m_tickRate / 60, 1); }
+
+    void reset() {
+        m_accumulator = 0;
+        m_tick        = 0;
+    }
+
+    void addTime(double seconds) {
+        m_accumulator = std::min(m_accumulator + std::max(seconds, 0.0), MAX_TICKS_PER_FRAME * m_tickSeconds);
+    }
+
+    /**
+     * Takes one tick off the accumulated time, returns false if less than a tick is left.
+     */
+    bool step() {
+        // A 60 Hz frame has to come out as exactly 4 ticks at 240 Hz, not 3 or 5 from rounding.
+        if (m_accumulator < m_tickSeconds - TOLERANCE) {
+            return false;
+        }
+
+        m_accumulator = std::max(m_accumulator - m_tickSeconds, 0.0);
+        m_tick++;
+        return true;
+    }
+
+    /**
+     * Ticks run since the last `reset`.
+     */
+    uint64_t getTick() const { return m_tick; }
+
+    /**
+     * Simulated seconds since the last `reset`, including time that was added but not ticked yet.
+     */
+    double getTime() const { return m_tick * m_tickSeconds + m_accumulator; }
+
+    /**
+     * The tick boundary at or after `time` (see `getTime`) as a number of ticks. Something that
+     * happened at `time` is first seen by the tick after that many ticks have run.
+     */
+    uint64_t tickAt(double time) const {
+        return (time > 0) ? static_cast<uint64_t>(std::ceil(time / m_tickSeconds - TOLERANCE / m_tickSeconds)) : 0;
+    }
+
+    /**
+     * How far the current frame is between the last tick and the next one, in 0..1. Used to draw the
+     * player in between the two.
+     */
+    float getAlpha() const { return static_cast<float>(std::min(m_accumulator / m_tickSeconds, 1.0)); }
+
+private:
+    static constexpr double TOLERANCE = 1e-7;
+
+    int m_tickRate        = SUBSTEP_TICK_RATE;
+    double m_tickSeconds  = 1.0 / SUBSTEP_TICK_RATE;
+    double m_accumulator  = 0;
+    uint64_t m_tick       = 0;
+};
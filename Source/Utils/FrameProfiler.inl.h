@@ -0,0 +1,170 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Per-phase frame timings for `PlayScene`, kept for the last `SAMPLE_COUNT` frames.
+ *
+ * A sample covers one `PlayScene::update` and the draw that follows it: `nextFrame` is called at the
+ * start of every update, closes the previous sample and opens a new one. Phases are timed with
+ * `Scope` and add up when a phase runs more than once per frame (physics ticks, collision checks).
+ * Nothing is timed while the profiler is disabled.
+ */
+class FrameProfiler {
+public:
+    enum Phase : uint8_t {
+        Physics,    ///< `PlayerObject::update`, every tick.
+        Collisions, ///< `PlayScene::checkCollisions`, every tick.
+        Camera,
+        Visibility,
+        Spawn,      ///< `PlayScene::checkSpawnObjects`.
+        Render,     ///< CPU side of `Director::drawScene`.
+        PhaseCount,
+    };
+
+    static constexpr size_t SAMPLE_COUNT = 240;
+
+    struct Sample {
+        float frameMs = 0; ///< Time since the previous frame's `nextFrame`.
+        std::array<float, PhaseCount> phaseMs {};
+    };
+
+    struct Stats {
+        float p50 = 0;
+        float p99 = 0;
+        float max = 0;
+    };
+
+    using clock = std::chrono::steady_clock;
+
+    class Scope {
+    public:
+        Scope(FrameProfiler& profiler, Phase phase) : m_profiler(profiler), m_phase(phase) {
+            if (m_profiler.m_enabled) {
+                m_start = clock::now();
+            }
+        }
+
+        ~Scope() {
+            if (m_profiler.m_enabled) {
+                m_profiler.add(m_phase, clock::now() - m_start);
+            }
+        }
+
+        Scope(const Scope&)            = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        FrameProfiler& m_profiler;
+        Phase m_phase;
+        clock::time_point m_start;
+    };
+
+    static const char* getPhaseName(Phase phase) {
+        static constexpr const char* names[PhaseCount] = {
+            "physics", "collisions", "camera", "visibility", "spawn", "render",
+        };
+        return (phase < PhaseCount) ? names[phase] : "";
+    }
+
+    bool isEnabled() const { return m_enabled; }
+
+    /**
+     * Also forgets all samples.
+     */
+    void setEnabled(bool enabled) {
+        m_enabled     = enabled;
+        m_sampleCount = 0;
+        m_nextSample  = 0;
+        m_current     = {};
+        m_frameStart  = {};
+    }
+
+    void nextFrame() {
+        if (!m_enabled) {
+            return;
+        }
+
+        clock::time_point now = clock::now();
+
+        if (m_frameStart != clock::time_point {}) {
+            m_current.frameMs = toMs(now - m_frameStart);
+
+            m_samples[m_nextSample] = m_current;
+            m_nextSample            = (m_nextSample + 1) % SAMPLE_COUNT;
+            m_sampleCount           = std::min(m_sampleCount + 1, SAMPLE_COUNT);
+        }
+
+        m_frameStart = now;
+        m_current    = {};
+    }
+
+    void add(Phase phase, clock::duration duration) {
+        m_current.phaseMs[phase] += toMs(duration);
+    }
+
+    size_t getSampleCount() const { return m_sampleCount; }
+
+    /**
+     * `age` 0 is the most recent finished frame.
+     */
+    const Sample& getSample(size_t age) const {
+        return m_samples[(m_nextSample + SAMPLE_COUNT - 1 - age) % SAMPLE_COUNT];
+    }
+
+    Stats getFrameStats() const {
+        return computeStats([](const Sample& sample) { return sample.frameMs; });
+    }
+
+    Stats getPhaseStats(Phase phase) const {
+        return computeStats([phase](const Sample& sample) { return sample.phaseMs[phase]; });
+    }
+
+private:
+    static float toMs(clock::duration duration) {
+        return std::chrono::duration<float, std::milli>(duration).count();
+    }
+
+    template <typename Get>
+    Stats computeStats(Get get) const {
+        Stats stats;
+
+        if (m_sampleCount == 0) {
+            return stats;
+        }
+
+        std::array<float, SAMPLE_COUNT> values;
+
+        for (size_t i = 0; i < m_sampleCount; i++) {
+            values[i] = get(m_samples[i]);
+        }
+
+        auto begin = values.begin();
+        auto end   = values.begin() + m_sampleCount;
+        auto p50   = begin + (m_sampleCount - 1) / 2;
+        auto p99   = begin + (m_sampleCount - 1) * 99 / 100;
+
+        std::nth_element(begin, p99, end);
+        stats.p99 = *p99;
+        stats.max = *std::max_element(p99, end);
+
+        std::nth_element(begin, p50, p99);
+        stats.p50 = *p50;
+
+        return stats;
+    }
+
+private:
+    bool m_enabled = false;
+
+    std::array<Sample, SAMPLE_COUNT> m_samples {};
+    size_t m_nextSample  = 0;
+    size_t m_sampleCount = 0;
+
+    Sample m_current;
+    clock::time_point m_frameStart;
+};
@@ -0,0 +1,249 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Objects/ObjectDescriptor.h"
+#include "Utils/LevelTokenizer.inl.h"
+
+/**
+ * Compact binary level format (`.tbl`).
+ *
+ * Layout (little endian, every block 4-byte aligned):
+ *
+ *     FileHeader
+ *     char[settingsSize]             the settings header of the text format (`kS1,91,...`)
+ *     ObjectRecord[objectCount]      sorted by section, text order preserved inside a section
+ *     SectionRecord[sectionCount]    range of ObjectRecords for every section
+ *
+ * The file is produced offline by `tombstone-levelc` and read in place (see `level_format::View`),
+ * so loading it is a bounds check followed by a walk over fixed-size records.
+ */
+namespace level_format {
+    constexpr char MAGIC[4]       = {'T', 'B', 'L', 'V'};
+    constexpr uint16_t VERSION    = 1;
+    constexpr float SECTION_WIDTH = 100.0f; ///< Must match `PlayScene::sectionForPos`.
+
+    enum ObjectFlags : uint8_t {
+        FlagFlipX = 1 << 0,
+        FlagFlipY = 1 << 1,
+    };
+
+    struct FileHeader {
+        char magic[4];
+        uint16_t version;
+        uint16_t headerSize;
+        uint32_t settingsOffset;
+        uint32_t settingsSize;
+        uint32_t objectsOffset;
+        uint32_t objectCount;
+        uint32_t sectionsOffset;
+        uint32_t sectionCount;
+    };
+    static_assert(sizeof(FileHeader) == 32);
+
+    struct ObjectRecord {
+        uint16_t objectKey;
+        int16_t rotation; ///< Whole degrees, the text format only stores integers.
+        float x;
+        float y;          ///< Already offset by the ground height, same as `ObjectDescriptor::y`.
+        float tintDuration;
+        uint8_t tint[3];
+        uint8_t flags;    ///< `ObjectFlags`
+    };
+    static_assert(sizeof(ObjectRecord) == 20);
+
+    // Records are read straight out of the mapped file, without any byte swapping.
+    static_assert(std::endian::native == std::endian::little, "level_format assumes a little endian host");
+
+    struct SectionRecord {
+        uint32_t firstObject;
+        uint32_t objectCount;
+    };
+    static_assert(sizeof(SectionRecord) == 8);
+
+    inline ObjectDescriptor to_descriptor(const ObjectRecord& record) {
+        ObjectDescriptor desc;
+        desc.objectKey    = record.objectKey;
+        desc.x            = record.x;
+        desc.y            = record.y;
+        desc.rotation     = record.rotation;
+        desc.flipX        = (record.flags & FlagFlipX) != 0;
+        desc.flipY        = (record.flags & FlagFlipY) != 0;
+        desc.tint         = {record.tint[0], record.tint[1], record.tint[2]};
+        desc.tintDuration = record.tintDuration;
+        return desc;
+    }
+
+    inline ObjectRecord to_record(const ObjectDescriptor& desc) {
+        ObjectRecord record {};
+        record.objectKey    = static_cast<uint16_t>(desc.objectKey);
+        record.rotation     = static_cast<int16_t>(desc.rotation);
+        record.x            = desc.x;
+        record.y            = desc.y;
+        record.tintDuration = desc.tintDuration;
+        record.tint[0]      = desc.tint.r;
+        record.tint[1]      = desc.tint.g;
+        record.tint[2]      = desc.tint.b;
+        record.flags        = (desc.flipX ? FlagFlipX : 0) | (desc.flipY ? FlagFlipY : 0);
+        return record;
+    }
+
+    inline int section_for_x(float x) {
+        return static_cast<int>(std::floor(x / SECTION_WIDTH));
+    }
+
+    inline bool is_binary_level(std::string_view data) {
+        return data.size() >= sizeof(MAGIC) && std::memcmp(data.data(), MAGIC, sizeof(MAGIC)) == 0;
+    }
+
+    /**
+     * Read-only view over a binary level held in memory (usually a mapped file).
+     * The records point straight into the buffer, nothing is copied.
+     */
+    class View {
+    public:
+        /**
+         * Validates `data` and sets up the view. Returns false for anything that isn't a
+         * well-formed level of a supported version.
+         */
+        bool init(std::string_view data) {
+            if (data.size() < sizeof(FileHeader) || !is_binary_level(data)) {
+                return false;
+            }
+
+            std::memcpy(&m_header, data.data(), sizeof(FileHeader));
+
+            if (m_header.version != VERSION || m_header.headerSize != sizeof(FileHeader)) {
+                return false;
+            }
+
+            if (!inBounds(data, m_header.settingsOffset, m_header.settingsSize, 1) ||
+                !inBounds(data, m_header.objectsOffset, m_header.objectCount, sizeof(ObjectRecord)) ||
+                !inBounds(data, m_header.sectionsOffset, m_header.sectionCount, sizeof(SectionRecord)))
+            {
+                return false;
+            }
+
+            if (m_header.objectsOffset % alignof(ObjectRecord) || m_header.sectionsOffset % alignof(SectionRecord) ||
+                reinterpret_cast<uintptr_t>(data.data()) % alignof(ObjectRecord))
+            {
+                return false;
+            }
+
+            m_settings = data.substr(m_header.settingsOffset, m_header.settingsSize);
+            m_objects  = {reinterpret_cast<const ObjectRecord*>(data.data() + m_header.objectsOffset),
+                          m_header.objectCount};
+            m_sections = {reinterpret_cast<const SectionRecord*>(data.data() + m_header.sectionsOffset),
+                          m_header.sectionCount};
+
+            for (const SectionRecord& section : m_sections) {
+                if (section.firstObject > m_objects.size() ||
+                    section.objectCount > m_objects.size() - section.firstObject)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        std::string_view getSettings() const { return m_settings; }
+        std::span<const ObjectRecord> getObjects() const { return m_objects; }
+        std::span<const SectionRecord> getSections() const { return m_sections; }
+
+        std::span<const ObjectRecord> getSectionObjects(size_t section) const {
+            const SectionRecord& record = m_sections[section];
+            return m_objects.subspan(record.firstObject, record.objectCount);
+        }
+
+    private:
+        static bool inBounds(std::string_view data, uint64_t offset, uint64_t count, uint64_t stride) {
+            return offset <= data.size() && count * stride <= data.size() - offset;
+        }
+
+    private:
+        FileHeader m_header {};
+        std::string_view m_settings;
+        std::span<const ObjectRecord> m_objects;
+        std::span<const SectionRecord> m_sections;
+    };
+
+    /**
+     * Converts a text level (`kS1,...;1,34,2,1,3,195;...`) into the binary format.
+     * Objects with a negative X are grouped with section 0, the section table has no negative entries.
+     */
+    inline std::string compile(std::string_view text) {
+        auto [settings, data] = level_tokenizer::split_header(text);
+
+        std::vector<ObjectRecord> records;
+        std::vector<int> recordSections;
+
+        level_tokenizer::for_each_object(data, [&](const ObjectDescriptor& desc) {
+            records.push_back(to_record(desc));
+            recordSections.push_back(std::max(section_for_x(desc.x), 0));
+        });
+
+        std::vector<uint32_t> order(records.size());
+        for (uint32_t i = 0; i < order.size(); i++) {
+            order[i] = i;
+        }
+
+        std::stable_sort(order.begin(), order.end(), [&recordSections](uint32_t lhs, uint32_t rhs) {
+            return recordSections[lhs] < recordSections[rhs];
+        });
+
+        size_t sectionCount = recordSections.empty()
+            ? 0 : static_cast<size_t>(*std::max_element(recordSections.begin(), recordSections.end())) + 1;
+
+        std::vector<SectionRecord> sections(sectionCount, SectionRecord {0, 0});
+        std::vector<ObjectRecord> sorted;
+        sorted.reserve(records.size());
+
+        for (uint32_t idx : order) {
+            SectionRecord& section = sections[recordSections[idx]];
+
+            if (section.objectCount == 0) {
+                section.firstObject = static_cast<uint32_t>(sorted.size());
+            }
+
+            section.objectCount++;
+            sorted.push_back(records[idx]);
+        }
+
+        auto align4 = [](size_t n) { return (n + 3) & ~size_t(3); };
+
+        FileHeader header {};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version        = VERSION;
+        header.headerSize     = sizeof(FileHeader);
+        header.settingsOffset = sizeof(FileHeader);
+        header.settingsSize   = static_cast<uint32_t>(settings.size());
+        header.objectsOffset  = static_cast<uint32_t>(align4(header.settingsOffset + header.settingsSize));
+        header.objectCount    = static_cast<uint32_t>(sorted.size());
+        header.sectionsOffset = header.objectsOffset + header.objectCount * sizeof(ObjectRecord);
+        header.sectionCount   = static_cast<uint32_t>(sections.size());
+
+        std::string out(header.sectionsOffset + header.sectionCount * sizeof(SectionRecord), '\0');
+
+        std::memcpy(out.data(), &header, sizeof(header));
+        std::memcpy(out.data() + header.settingsOffset, settings.data(), settings.size());
+
+        if (!sorted.empty()) {
+            std::memcpy(out.data() + header.objectsOffset, sorted.data(), sorted.size() * sizeof(ObjectRecord));
+        }
+
+        if (!sections.empty()) {
+            std::memcpy(out.data() + header.sectionsOffset, sections.data(), sections.size() * sizeof(SectionRecord));
+        }
+
+        return out;
+    }
+}
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <charconv>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "Objects/ObjectDescriptor.h"
+
+/**
+ * Single-pass, allocation-free tokenizer for the `key,value,key,value;...` level format.
+ *
+ * Every function here works on views into the buffer owned by `Level`, so the buffer
+ * has to outlive whatever is done with the returned views.
+ */
+namespace level_tokenizer {
+    enum class ObjectPropertyID {
+        Invalid      = 0,
+        ObjectID     = 1,
+        PosX         = 2,
+        PosY         = 3,
+        FlipX        = 4,
+        FlipY        = 5,
+        Rotation     = 6,
+        TintR        = 7,
+        TintG        = 8,
+        TintB        = 9,
+        TintDuration = 10
+    };
+
+    /**
+     * Parses the leading integer of `str`. Like `std::stoi`, anything after the number
+     * (e.g. a fractional part) is ignored. Returns false if `str` doesn't start with a number.
+     */
+    inline bool parse_int(std::string_view str, int& out) {
+        const char* first = str.data();
+        const char* last  = first + str.size();
+
+        if (first != last && *first == '+') {
+            ++first;
+        }
+
+        return std::from_chars(first, last, out).ec == std::errc();
+    }
+
+    /**
+     * Parses a plain decimal number (`-12`, `0.5`, `.25`). Exponents aren't used by the
+     * level format and aren't supported. `std::from_chars` for floats isn't available on
+     * every standard library we ship with, hence the manual fraction handling.
+     */
+    inline bool parse_float(std::string_view str, float& out) {
+        size_t pos    = 0;
+        bool negative = false;
+
+        if (pos < str.size() && (str[pos] == '-' || str[pos] == '+')) {
+            negative = str[pos] == '-';
+            ++pos;
+        }
+
+        bool hasDigits = false;
+        double value   = 0;
+
+        for (; pos < str.size() && str[pos] >= '0' && str[pos] <= '9'; ++pos) {
+            value     = value * 10 + (str[pos] - '0');
+            hasDigits = true;
+        }
+
+        if (pos < str.size() && str[pos] == '.') {
+            double scale = 0.1;
+
+            for (++pos; pos < str.size() && str[pos] >= '0' && str[pos] <= '9'; ++pos) {
+                value += (str[pos] - '0') * scale;
+                scale *= 0.1;
+                hasDigits = true;
+            }
+        }
+
+        if (!hasDigits) {
+            return false;
+        }
+
+        out = static_cast<float>(negative ? -value : value);
+        return true;
+    }
+
+    /**
+     * Returns the token up to the next `delim` and advances `str` past it.
+     */
+    inline std::string_view next_token(std::string_view& str, char delim) {
+        size_t n = str.find(delim);
+
+        if (n == std::string_view::npos) {
+            std::string_view token = str;
+            str                    = {};
+            return token;
+        }
+
+        std::string_view token = str.substr(0, n);
+        str.remove_prefix(n + 1);
+        return token;
+    }
+
+    /**
+     * Splits the level string into its settings header and the object data.
+     */
+    inline std::pair<std::string_view, std::string_view> split_header(std::string_view level) {
+        size_t n = level.find(';');
+
+        if (n == std::string_view::npos) {
+            return {level, {}};
+        }
+
+        return {level.substr(0, n), level.substr(n + 1)};
+    }
+
+    /**
+     * Calls `callback(key, value)` for every `key,value` pair of `str`.
+     */
+    template <typename Callback>
+    inline void for_each_pair(std::string_view str, Callback&& callback) {
+        while (!str.empty()) {
+            std::string_view key   = next_token(str, ',');
+            std::string_view value = next_token(str, ',');
+
+            callback(key, value);
+        }
+    }
+
+    /**
+     * Parses one object string (`1,34,2,1,3,195`).
+     * Positions are converted to game space, i.e. the ground offset is applied to Y.
+     */
+    inline ObjectDescriptor parse_object(std::string_view str) {
+        ObjectDescriptor desc;
+
+        while (!str.empty()) {
+            int key = 0;
+
+            if (!parse_int(next_token(str, ','), key)) {
+                break;
+            }
+
+            std::string_view value = next_token(str, ',');
+            int intValue           = 0;
+
+            switch (static_cast<ObjectPropertyID>(key)) {
+                case ObjectPropertyID::ObjectID:
+                    parse_int(value, desc.objectKey);
+                    break;
+                case ObjectPropertyID::PosX:
+                    parse_int(value, intValue);
+                    desc.x = static_cast<float>(intValue);
+                    break;
+                case ObjectPropertyID::PosY:
+                    parse_int(value, intValue);
+                    desc.y = static_cast<float>(intValue) + 90;
+                    break;
+                case ObjectPropertyID::Rotation:
+                    parse_int(value, intValue);
+                    desc.rotation = static_cast<float>(intValue);
+                    break;
+                case ObjectPropertyID::FlipX:
+                    parse_int(value, intValue);
+                    desc.flipX = intValue != 0;
+                    break;
+                case ObjectPropertyID::FlipY:
+                    parse_int(value, intValue);
+                    desc.flipY = intValue != 0;
+                    break;
+                case ObjectPropertyID::TintR:
+                    parse_int(value, intValue);
+                    desc.tint.r = static_cast<uint8_t>(intValue);
+                    break;
+                case ObjectPropertyID::TintG:
+                    parse_int(value, intValue);
+                    desc.tint.g = static_cast<uint8_t>(intValue);
+                    break;
+                case ObjectPropertyID::TintB:
+                    parse_int(value, intValue);
+                    desc.tint.b = static_cast<uint8_t>(intValue);
+                    break;
+                case ObjectPropertyID::TintDuration:
+                    parse_float(value, desc.tintDuration);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        return desc;
+    }
+
+    /**
+     * Calls `callback(const ObjectDescriptor&)` for every object in the data part of a level string.
+     * Empty entries (e.g. the trailing `;`) are skipped.
+     *
+     * A callback returning `bool` can stop early by returning false, the function returns false then.
+     */
+    template <typename Callback>
+    inline bool for_each_object(std::string_view data, Callback&& callback) {
+        while (!data.empty()) {
+            std::string_view object = next_token(data, ';');
+
+            if (object.empty() || object == "\n") {
+                continue;
+            }
+
+            if constexpr (std::is_same_v<std::invoke_result_t<Callback&, const ObjectDescriptor&>, bool>) {
+                if (!callback(parse_object(object))) {
+                    return false;
+                }
+            } else {
+                callback(parse_object(object));
+            }
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#if defined(_WIN32)
+#    ifndef WIN32_LEAN_AND_MEAN
+#        define WIN32_LEAN_AND_MEAN
+#    endif
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+/**
+ * Read-only memory mapping of a file on disk.
+ *
+ * Only works for real files, so callers should fall back to reading the file into memory
+ * when `open` fails (e.g. for assets packed inside an APK).
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path) {
+        close();
+
+#if defined(WINAPI_FAMILY) && (WINAPI_FAMILY == WINAPI_FAMILY_APP)
+        // No CreateFileA on UWP, callers read the whole file instead.
+        return false;
+#elif defined(_WIN32)
+        m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+        if (m_file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+
+        LARGE_INTEGER size;
+
+        if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0) {
+            close();
+            return false;
+        }
+
+        m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        if (!m_mapping) {
+            close();
+            return false;
+        }
+
+        m_data = MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+        m_size = static_cast<size_t>(size.QuadPart);
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+
+        if (fd < 0) {
+            return false;
+        }
+
+        struct stat st;
+
+        if (fstat(fd, &st) != 0 || st.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+
+        m_size = static_cast<size_t>(st.st_size);
+        m_data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        // The mapping keeps its own reference to the file.
+        ::close(fd);
+
+        if (m_data == MAP_FAILED) {
+            m_data = nullptr;
+        }
+#endif
+
+        if (!m_data) {
+            close();
+            return false;
+        }
+
+        return true;
+    }
+
+    void close() {
+#if defined(_WIN32)
+        if (m_data) {
+            UnmapViewOfFile(m_data);
+        }
+
+        if (m_mapping) {
+            CloseHandle(m_mapping);
+        }
+
+        if (m_file != INVALID_HANDLE_VALUE) {
+            CloseHandle(m_file);
+        }
+
+        m_mapping = nullptr;
+        m_file    = INVALID_HANDLE_VALUE;
+#else
+        if (m_data) {
+            munmap(m_data, m_size);
+        }
+#endif
+
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    bool isOpen() const { return m_data != nullptr; }
+
+    std::string_view getData() const {
+        return {static_cast<const char*>(m_data), m_size};
+    }
+
+private:
+    void* m_data  = nullptr;
+    size_t m_size = 0;
+
+#if defined(_WIN32)
+    HANDLE m_file    = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+#endif
+};
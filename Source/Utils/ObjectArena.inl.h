@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+/**
+ * Type-segregated slab allocator. Every `T` lives in a fixed-size slot inside a chunk of
+ * `ChunkSlots` slots, freed slots are kept in an intrusive free list and the chunks themselves
+ * are given back in one go once the last object is gone (i.e. when the scene is torn down).
+ *
+ * Requests of any other size (derived classes) go straight to the global allocator.
+ * Not thread safe, nodes are only created and destroyed on the main thread.
+ */
+template <typename T, size_t ChunkSlots = 256>
+class ObjectArena {
+public:
+    static ObjectArena& getInstance() {
+        static ObjectArena singleton;
+        return singleton;
+    }
+
+    void* allocate(size_t size) {
+        if (size != sizeof(T)) {
+            return ::operator new(size);
+        }
+
+        if (!m_freeList) {
+            grow();
+        }
+
+        Slot* slot = m_freeList;
+        m_freeList = slot->next;
+        m_liveObjects++;
+
+        return slot->storage;
+    }
+
+    /**
+     * `allocate` for `new (std::nothrow)`, returns null instead of throwing when out of memory.
+     */
+    void* allocate(size_t size, const std::nothrow_t&) noexcept {
+        if (size != sizeof(T)) {
+            return ::operator new(size, std::nothrow);
+        }
+
+        try {
+            return allocate(size);
+        } catch (const std::bad_alloc&) {
+            return nullptr;
+        }
+    }
+
+    void deallocate(void* ptr, size_t size) {
+        if (!ptr) {
+            return;
+        }
+
+        if (size != sizeof(T)) {
+            ::operator delete(ptr);
+            return;
+        }
+
+        Slot* slot = reinterpret_cast<Slot*>(ptr);
+        slot->next = m_freeList;
+        m_freeList = slot;
+
+        if (--m_liveObjects == 0) {
+            releaseChunks();
+        }
+    }
+
+    /**
+     * For the unsized `operator delete` overloads, which don't know whether `ptr` came from a slot.
+     */
+    bool owns(const void* ptr) const {
+        auto address = reinterpret_cast<const unsigned char*>(ptr);
+
+        for (const auto& chunk : m_chunks) {
+            auto first = reinterpret_cast<const unsigned char*>(chunk.get());
+
+            if (address >= first && address < first + sizeof(Slot) * ChunkSlots) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    size_t getLiveObjects() const { return m_liveObjects; }
+    size_t getCapacity() const { return m_chunks.size() * ChunkSlots; }
+
+private:
+    union Slot {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    void grow() {
+        // Stored before it's linked in, so a throwing `push_back` leaves the free list untouched.
+        m_chunks.push_back(std::make_unique<Slot[]>(ChunkSlots));
+        Slot* chunk = m_chunks.back().get();
+
+        for (size_t i = 0; i < ChunkSlots; i++) {
+            chunk[i].next = (i + 1 < ChunkSlots) ? &chunk[i + 1] : m_freeList;
+        }
+
+        m_freeList = chunk;
+    }
+
+    void releaseChunks() {
+        m_chunks.clear();
+        m_freeList = nullptr;
+    }
+
+private:
+    std::vector<std::unique_ptr<Slot[]>> m_chunks;
+    Slot* m_freeList     = nullptr;
+    size_t m_liveObjects = 0;
+};
+
+/**
+ * Mix into a class to allocate it (but not its subclasses) from `ObjectArena<T>`.
+ * The nothrow overloads are needed because `ax::utils::createInstance` uses `new (std::nothrow)`.
+ */
+template <typename T>
+struct ArenaAllocated {
+    static void* operator new(size_t size) {
+        return ObjectArena<T>::getInstance().allocate(size);
+    }
+
+    static void* operator new(size_t size, const std::nothrow_t& tag) noexcept {
+        return ObjectArena<T>::getInstance().allocate(size, tag);
+    }
+
+    static void operator delete(void* ptr, size_t size) noexcept {
+        ObjectArena<T>::getInstance().deallocate(ptr, size);
+    }
+
+    static void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+        ObjectArena<T>& arena = ObjectArena<T>::getInstance();
+        arena.deallocate(ptr, arena.owns(ptr) ? sizeof(T) : 0);
+    }
+};
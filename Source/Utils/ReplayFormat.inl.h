@@ -0,0 +1,142 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Binary input replay format (`.tbrp`).
+ *
+ * Layout (little endian):
+ *
+ *     FileHeader
+ *     uint8_t[dataSize]    one varint per event: (ticks since the previous event << 1) | press
+ *
+ * An event at tick `n` is applied after `n` physics ticks have run, before tick `n + 1`, so a replay
+ * only reproduces a run at the `tickRate` it was recorded at (see `FixedTimestep`).
+ */
+namespace replay_format {
+    constexpr char MAGIC[4]    = {'T', 'B', 'R', 'P'};
+    constexpr uint16_t VERSION = 1;
+
+    struct FileHeader {
+        char magic[4];
+        uint16_t version;
+        uint16_t tickRate;
+        uint32_t eventCount;
+        uint32_t dataSize;
+        uint64_t tickCount; ///< How long the recorded run went on for.
+    };
+    static_assert(sizeof(FileHeader) == 24);
+
+    // The header is copied in and out as it is, without any byte swapping.
+    static_assert(std::endian::native == std::endian::little, "replay_format assumes a little endian host");
+
+    struct Event {
+        uint64_t tick;
+        bool press;
+
+        bool operator==(const Event&) const = default;
+    };
+
+    struct Replay {
+        uint16_t tickRate  = 0;
+        uint64_t tickCount = 0;
+        std::vector<Event> events; ///< Sorted by tick.
+
+        void clear() {
+            tickCount = 0;
+            events.clear();
+        }
+
+        void record(uint64_t tick, bool press) {
+            events.push_back({tick, press});
+        }
+
+        bool operator==(const Replay&) const = default;
+    };
+
+    inline bool is_replay(std::string_view data) {
+        return data.size() >= sizeof(MAGIC) && std::memcmp(data.data(), MAGIC, sizeof(MAGIC)) == 0;
+    }
+
+    inline std::string encode(const Replay& replay) {
+        std::string data(sizeof(FileHeader), '\0');
+        uint64_t lastTick = 0;
+
+        for (const Event& event : replay.events) {
+            uint64_t value = ((event.tick - lastTick) << 1) | (event.press ? 1 : 0);
+            lastTick       = event.tick;
+
+            do {
+                uint8_t byte = value & 0x7f;
+                value >>= 7;
+                data.push_back(static_cast<char>(byte | (value ? 0x80 : 0)));
+            } while (value);
+        }
+
+        FileHeader header {};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version    = VERSION;
+        header.tickRate   = replay.tickRate;
+        header.eventCount = static_cast<uint32_t>(replay.events.size());
+        header.dataSize   = static_cast<uint32_t>(data.size() - sizeof(FileHeader));
+        header.tickCount  = replay.tickCount;
+        std::memcpy(data.data(), &header, sizeof(FileHeader));
+
+        return data;
+    }
+
+    /**
+     * Returns false for anything that isn't a well-formed replay of a supported version.
+     */
+    inline bool decode(std::string_view data, Replay& replay) {
+        FileHeader header;
+
+        if (data.size() < sizeof(FileHeader) || !is_replay(data)) {
+            return false;
+        }
+
+        std::memcpy(&header, data.data(), sizeof(FileHeader));
+
+        if (header.version != VERSION || header.tickRate == 0 || header.dataSize != data.size() - sizeof(FileHeader)) {
+            return false;
+        }
+
+        // Every event takes at least one byte.
+        if (header.eventCount > header.dataSize) {
+            return false;
+        }
+
+        replay.tickRate  = header.tickRate;
+        replay.tickCount = header.tickCount;
+        replay.events.clear();
+        replay.events.reserve(header.eventCount);
+
+        const auto* it  = reinterpret_cast<const uint8_t*>(data.data() + sizeof(FileHeader));
+        const auto* end = it + header.dataSize;
+        uint64_t tick   = 0;
+
+        for (uint32_t i = 0; i < header.eventCount; i++) {
+            uint64_t value = 0;
+            int shift      = 0;
+
+            do {
+                if (it == end || shift > 63) {
+                    return false;
+                }
+
+                value |= static_cast<uint64_t>(*it & 0x7f) << shift;
+                shift += 7;
+            } while (*it++ & 0x80);
+
+            tick += value >> 1;
+            replay.events.push_back({tick, (value & 1) != 0});
+        }
+
+        return it == end;
+    }
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cmath>
+#include <string_view>
+
+#include "Utils/LevelTokenizer.inl.h"
+
+/**
+ * Reads frame sizes out of a sprite sheet plist (`GJ_GameSheet.plist`) without the engine, for
+ * tools that need the hitboxes the game derives from them.
+ *
+ * Only understands what the sprite frame plists shipped with the game use: an XML plist with a
+ * `frames` dictionary of one dictionary per frame, in any of the formats `SpriteFrameCache` reads
+ * (0 to 3). Frame dictionaries don't nest.
+ */
+namespace sprite_sheet {
+    struct FrameSize {
+        float width;
+        float height;
+    };
+
+    /**
+     * Text of the value element that follows `<key>key</key>` in `dict`, e.g. `{30,30}` for
+     * `<string>{30,30}</string>`. Empty if the key isn't there or its value has no text.
+     */
+    inline std::string_view value_for_key(std::string_view dict, std::string_view key) {
+        size_t pos = 0;
+
+        while ((pos = dict.find("<key>", pos)) != std::string_view::npos) {
+            pos += 5;
+
+            size_t end = dict.find("</key>", pos);
+
+            if (end == std::string_view::npos) {
+                return {};
+            }
+
+            if (dict.substr(pos, end - pos) != key) {
+                pos = end;
+                continue;
+            }
+
+            size_t open = dict.find('<', end + 6);
+            size_t text = (open == std::string_view::npos) ? open : dict.find('>', open);
+
+            if (text == std::string_view::npos || dict[text - 1] == '/') {
+                return {};
+            }
+
+            size_t close = dict.find('<', text + 1);
+            return (close == std::string_view::npos) ? std::string_view {} : dict.substr(text + 1, close - text - 1);
+        }
+
+        return {};
+    }
+
+    /**
+     * Parses a `{width,height}` string like `SpriteFrameCache` does, spaces are allowed.
+     */
+    inline bool parse_size(std::string_view str, FrameSize& out) {
+        size_t open  = str.find('{');
+        size_t comma = str.find(',', open);
+        size_t close = str.find('}', comma);
+
+        if (open == std::string_view::npos || comma == std::string_view::npos || close == std::string_view::npos) {
+            return false;
+        }
+
+        auto trim = [](std::string_view token) {
+            size_t first = token.find_first_not_of(" \t");
+            return (first == std::string_view::npos) ? std::string_view {} : token.substr(first);
+        };
+
+        return level_tokenizer::parse_float(trim(str.substr(open + 1, comma - open - 1)), out.width) &&
+               level_tokenizer::parse_float(trim(str.substr(comma + 1, close - comma - 1)), out.height);
+    }
+
+    /**
+     * Untrimmed size of one frame, which is what a sprite of it gets as its content size. `dict` is
+     * the body of the frame's dictionary.
+     */
+    inline bool parse_frame_size(std::string_view dict, FrameSize& out) {
+        // Format 3, then 1 and 2.
+        for (std::string_view key : {"spriteSourceSize", "sourceSize"}) {
+            if (std::string_view value = value_for_key(dict, key); !value.empty()) {
+                return parse_size(value, out);
+            }
+        }
+
+        // Format 0.
+        if (!level_tokenizer::parse_float(value_for_key(dict, "originalWidth"), out.width) ||
+            !level_tokenizer::parse_float(value_for_key(dict, "originalHeight"), out.height))
+        {
+            return false;
+        }
+
+        out.width  = std::fabs(out.width);
+        out.height = std::fabs(out.height);
+        return true;
+    }
+
+    /**
+     * Calls `callback(std::string_view name, const FrameSize& size)` for every frame of the sheet,
+     * with sizes in pixels of the sheet's texture. Frames without a readable size are skipped.
+     * Returns false if `plist` has no `frames` dictionary.
+     */
+    template <typename Callback>
+    inline bool for_each_frame_size(std::string_view plist, Callback&& callback) {
+        size_t pos = plist.find("<key>frames</key>");
+
+        if (pos == std::string_view::npos || (pos = plist.find("<dict>", pos)) == std::string_view::npos) {
+            return false;
+        }
+
+        pos += 6;
+
+        while (true) {
+            size_t key     = plist.find("<key>", pos);
+            size_t dictEnd = plist.find("</dict>", pos);
+
+            // The next closing tag is the one of `frames` itself.
+            if (key == std::string_view::npos || dictEnd < key) {
+                return true;
+            }
+
+            size_t keyEnd = plist.find("</key>", key);
+            size_t open   = (keyEnd == std::string_view::npos) ? keyEnd : plist.find("<dict>", keyEnd);
+            size_t close  = (open == std::string_view::npos) ? open : plist.find("</dict>", open);
+
+            if (close == std::string_view::npos) {
+                return true;
+            }
+
+            FrameSize size;
+
+            if (parse_frame_size(plist.substr(open + 6, close - open - 6), size)) {
+                callback(plist.substr(key + 5, keyEnd - key - 5), size);
+            }
+
+            pos = close + 7;
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+/**
+ * Fixed-size lock-free ring buffer for exactly one producer thread and one consumer thread.
+ *
+ * `push` is only ever called by the producer and `pop` by the consumer. Neither blocks or allocates,
+ * a full ring rejects the element instead. `Capacity` has to be a power of two.
+ */
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity has to be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>);
+
+public:
+    /**
+     * Producer only. Returns false if the ring is full.
+     */
+    bool push(const T& value) {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+
+        if (head - m_cachedTail == Capacity) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+
+            if (head - m_cachedTail == Capacity) {
+                return false;
+            }
+        }
+
+        m_slots[head & (Capacity - 1)] = value;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Consumer only. Returns false if the ring is empty.
+     */
+    bool pop(T& value) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+
+        if (tail == m_cachedHead) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+
+            if (tail == m_cachedHead) {
+                return false;
+            }
+        }
+
+        value = m_slots[tail & (Capacity - 1)];
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    // Producer and consumer each keep their index (and their copy of the other one) on their own
+    // cache line, so they only share a line when one actually has to look at the other.
+    alignas(CACHE_LINE) std::atomic<size_t> m_head {0};
+    size_t m_cachedTail = 0;
+
+    alignas(CACHE_LINE) std::atomic<size_t> m_tail {0};
+    size_t m_cachedHead = 0;
+
+    alignas(CACHE_LINE) T m_slots[Capacity];
+};
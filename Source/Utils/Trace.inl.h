@@ -0,0 +1,252 @@
+#pragma once
+
+/**
+ * Scoped timeline markers, written out as a Chrome trace (`chrome://tracing`, ui.perfetto.dev).
+ *
+ *     TRACE_SCOPE("PlayScene::update");      // from here to the end of the block
+ *     TRACE_THREAD_NAME("LevelLoader");      // label for the calling thread
+ *     TRACE_SET_OUTPUT(path);                // where TRACE_FLUSH writes to
+ *     TRACE_FLUSH();                         // on exit
+ *
+ * Only compiled in with the `TOMBSTONE_TRACING` CMake option, otherwise every macro expands to
+ * nothing. Names have to outlive the trace (string literals).
+ *
+ * Every thread appends to its own buffer: the owner is the only writer and publishes the event count
+ * with a release store, so recording never takes a lock and `write_chrome_trace` can read the
+ * buffers while the threads keep going. Buffers grow in fixed chunks and stop recording once
+ * `MAX_CHUNKS` are full, dropped events are counted in the trace's metadata.
+ */
+
+#if defined(TOMBSTONE_TRACING)
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace trace {
+    struct Event {
+        const char* name;
+        uint64_t startNs;
+        uint64_t durationNs;
+    };
+
+    class ThreadBuffer {
+    public:
+        static constexpr size_t CHUNK_SIZE = 4096;
+        static constexpr size_t MAX_CHUNKS = 512; ///< 2M events, 48 MB per thread at most.
+
+        explicit ThreadBuffer(uint32_t tid) : m_tid(tid) {}
+
+        ~ThreadBuffer() {
+            for (auto& chunk : m_chunks) {
+                delete[] chunk.load(std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * Owner thread only.
+         */
+        void push(const Event& event) {
+            const size_t index = m_count.load(std::memory_order_relaxed);
+            const size_t chunk = index / CHUNK_SIZE;
+
+            if (chunk >= MAX_CHUNKS) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            Event* events = m_chunks[chunk].load(std::memory_order_relaxed);
+
+            if (!events) {
+                events = new Event[CHUNK_SIZE];
+                m_chunks[chunk].store(events, std::memory_order_release);
+            }
+
+            events[index % CHUNK_SIZE] = event;
+            m_count.store(index + 1, std::memory_order_release);
+        }
+
+        size_t size() const { return m_count.load(std::memory_order_acquire); }
+
+        /**
+         * Any thread, for `i < size()`.
+         */
+        const Event& at(size_t i) const {
+            return m_chunks[i / CHUNK_SIZE].load(std::memory_order_acquire)[i % CHUNK_SIZE];
+        }
+
+        uint32_t getTid() const { return m_tid; }
+        uint64_t getDropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+        const char* getName() const { return m_name.load(std::memory_order_acquire); }
+        void setName(const char* name) { m_name.store(name, std::memory_order_release); }
+
+    private:
+        uint32_t m_tid;
+        std::atomic<const char*> m_name {nullptr};
+        std::atomic<size_t> m_count {0};
+        std::atomic<uint64_t> m_dropped {0};
+        std::atomic<Event*> m_chunks[MAX_CHUNKS] {};
+    };
+
+    /**
+     * Every buffer ever created. Buffers of threads that have ended stay, their events still belong
+     * in the trace.
+     */
+    struct Registry {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+        std::string outputPath = "trace.json";
+        const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+        static Registry& get() {
+            static Registry registry;
+            return registry;
+        }
+    };
+
+    inline uint64_t now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                                    Registry::get().epoch).count();
+    }
+
+    inline ThreadBuffer& local_buffer() {
+        thread_local ThreadBuffer* buffer = [] {
+            Registry& registry = Registry::get();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+
+            auto tid = static_cast<uint32_t>(registry.buffers.size() + 1);
+            registry.buffers.push_back(std::make_unique<ThreadBuffer>(tid));
+            return registry.buffers.back().get();
+        }();
+
+        return *buffer;
+    }
+
+    class Scope {
+    public:
+        explicit Scope(const char* name) : m_name(name), m_start(now_ns()) {}
+
+        ~Scope() {
+            local_buffer().push({m_name, m_start, now_ns() - m_start});
+        }
+
+        Scope(const Scope&)            = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char* m_name;
+        uint64_t m_start;
+    };
+
+    inline void set_thread_name(const char* name) {
+        local_buffer().setName(name);
+    }
+
+    inline void set_output_path(std::string path) {
+        Registry& registry = Registry::get();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.outputPath = std::move(path);
+    }
+
+    inline void write_json_string(FILE* file, const char* text) {
+        std::fputc('"', file);
+
+        for (const char* c = text; *c; c++) {
+            if (*c == '"' || *c == '\\') {
+                std::fputc('\\', file);
+            }
+
+            std::fputc(static_cast<unsigned char>(*c) < 0x20 ? ' ' : *c, file);
+        }
+
+        std::fputc('"', file);
+    }
+
+    /**
+     * Writes every event recorded so far as Chrome trace JSON ("X" events, microseconds).
+     */
+    inline bool write_chrome_trace(const std::string& path) {
+        Registry& registry = Registry::get();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        FILE* file = std::fopen(path.c_str(), "wb");
+
+        if (!file) {
+            return false;
+        }
+
+        std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+        bool first = true;
+
+        auto separator = [&] {
+            std::fputs(first ? "" : ",\n", file);
+            first = false;
+        };
+
+        for (const auto& buffer : registry.buffers) {
+            const uint32_t tid = buffer->getTid();
+
+            if (const char* name = buffer->getName()) {
+                separator();
+                std::fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", tid);
+                write_json_string(file, name);
+                std::fputs("}}", file);
+            }
+
+            if (uint64_t dropped = buffer->getDropped()) {
+                separator();
+                std::fprintf(file, "{\"name\":\"dropped_events\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+                                   "\"args\":{\"count\":%llu}}", tid, static_cast<unsigned long long>(dropped));
+            }
+
+            const size_t count = buffer->size();
+
+            for (size_t i = 0; i < count; i++) {
+                const Event& event = buffer->at(i);
+
+                separator();
+                std::fputs("{\"name\":", file);
+                write_json_string(file, event.name);
+                std::fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", tid,
+                             event.startNs / 1000.0, event.durationNs / 1000.0);
+            }
+        }
+
+        std::fputs("\n]}\n", file);
+        return std::fclose(file) == 0;
+    }
+
+    inline bool flush() {
+        std::string path;
+
+        {
+            Registry& registry = Registry::get();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            path = registry.outputPath;
+        }
+
+        return write_chrome_trace(path);
+    }
+}
+
+#    define TRACE_CONCAT_INNER(a, b) a##b
+#    define TRACE_CONCAT(a, b)       TRACE_CONCAT_INNER(a, b)
+#    define TRACE_SCOPE(name)        ::trace::Scope TRACE_CONCAT(traceScope, __LINE__)(name)
+#    define TRACE_THREAD_NAME(name)  ::trace::set_thread_name(name)
+#    define TRACE_SET_OUTPUT(path)   ::trace::set_output_path(path)
+#    define TRACE_FLUSH()            ::trace::flush()
+
+#else
+
+#    define TRACE_SCOPE(name)       ((void)0)
+#    define TRACE_THREAD_NAME(name) ((void)0)
+#    define TRACE_SET_OUTPUT(path)  ((void)0)
+#    define TRACE_FLUSH()           ((void)0)
+
+#endif
@@ -0,0 +1,55 @@
+/**
+ * tombstone-levelc: compiles a text level (`kS1,...;1,34,2,1,3,195;...`) into the binary
+ * format described in `Utils/LevelFormat.inl.h`.
+ *
+ *     tombstone-levelc <input.txt> <output.tbl>
+ */
+
+#include "Utils/LevelFormat.inl.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::fprintf(stderr, "usage: %s <input.txt> <output.tbl>\n", argv[0]);
+        return 1;
+    }
+
+    std::ifstream input(argv[1], std::ios::binary);
+
+    if (!input) {
+        std::fprintf(stderr, "error: can't open %s\n", argv[1]);
+        return 1;
+    }
+
+    std::ostringstream text;
+    text << input.rdbuf();
+
+    if (level_format::is_binary_level(text.str())) {
+        std::fprintf(stderr, "error: %s is already a binary level\n", argv[1]);
+        return 1;
+    }
+
+    std::string binary = level_format::compile(text.str());
+
+    level_format::View view;
+
+    if (!view.init(binary)) {
+        std::fprintf(stderr, "error: produced an invalid level, this is a bug\n");
+        return 1;
+    }
+
+    std::ofstream output(argv[2], std::ios::binary | std::ios::trunc);
+
+    if (!output.write(binary.data(), static_cast<std::streamsize>(binary.size()))) {
+        std::fprintf(stderr, "error: can't write %s\n", argv[2]);
+        return 1;
+    }
+
+    std::printf("%s: %zu objects in %zu sections, %zu -> %zu bytes\n", argv[2], view.getObjects().size(),
+                view.getSections().size(), text.str().size(), binary.size());
+
+    return 0;
+}
@@ -0,0 +1,352 @@
+#include "Simulation.h"
+
+#include "Objects/ObjectDictionary.h"
+#include "Objects/ObjectTraits.h"
+#include "Utils/LevelFormat.inl.h"
+#include "Utils/LevelTokenizer.inl.h"
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+
+bool Simulation::loadObjectDictionary(std::string_view json) {
+    m_keyToFrame.clear();
+
+    try {
+        return parseObjectDictionary(json, m_keyToFrame);
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+bool Simulation::loadSpriteSheet(std::string_view plist, float contentScale) {
+    m_frameSizes.clear();
+
+    return sprite_sheet::for_each_frame_size(plist, [&](std::string_view name, const sprite_sheet::FrameSize& size) {
+        m_frameSizes[std::string(name)] = {size.width / contentScale, size.height / contentScale};
+    });
+}
+
+bool Simulation::loadLevel(std::string_view data) {
+    m_objects.clear();
+    m_collisionGrid.clear();
+    m_hazardIndex.clear();
+    m_maxObjectXPos = 0;
+    m_startX        = 0;
+    m_startY        = 105;
+
+    if (level_format::is_binary_level(data)) {
+        level_format::View view;
+
+        if (!view.init(data)) {
+            return false;
+        }
+
+        for (const level_format::ObjectRecord& record : view.getObjects()) {
+            addObject(level_format::to_descriptor(record));
+        }
+    } else {
+        level_tokenizer::for_each_object(level_tokenizer::split_header(data).second, [this](const ObjectDescriptor& desc) {
+            addObject(desc);
+        });
+    }
+
+    // `PlayScene::finishLevelLoading`, without the screen width.
+    m_levelLength = m_maxObjectXPos + 340;
+
+    reset();
+    return true;
+}
+
+void Simulation::addObject(const ObjectDescriptor& desc) {
+    auto frame = m_keyToFrame.find(desc.objectKey);
+
+    if (frame == m_keyToFrame.end()) {
+        return;
+    }
+
+    ObjectTraits traits = objectTraitsForKey(desc.objectKey, frame->second);
+
+    // `GameObject::init` takes the sprite's content size, `customSetup` applies the override.
+    sprite_sheet::FrameSize size = {DEFAULT_OBJECT_SIZE, DEFAULT_OBJECT_SIZE};
+
+    if (traits.sizeOverride) {
+        size = {*traits.sizeOverride, *traits.sizeOverride};
+    } else if (auto frameSize = m_frameSizes.find(frame->second); frameSize != m_frameSizes.end()) {
+        size = frameSize->second;
+    }
+
+    float width  = size.width * traits.scaleModX;
+    float height = size.height * traits.scaleModY;
+
+    if (std::fabs(desc.rotation) == 90 || std::fabs(desc.rotation) == 270) {
+        std::swap(width, height);
+    }
+
+    CollisionRect rect = {desc.x - width / 2, desc.y - height / 2, desc.x + width / 2, desc.y + height / 2};
+
+    Object object;
+    object.x         = desc.x;
+    object.y         = desc.y;
+    object.rotation  = desc.rotation;
+    object.flipY     = desc.flipY;
+    object.activated = false;
+
+    m_maxObjectXPos = std::max(m_maxObjectXPos, desc.x);
+
+    if (desc.objectKey == 31 && desc.x > m_startX) {
+        m_startX = desc.x;
+        m_startY = desc.y;
+    }
+
+    int section   = std::max(sectionForX(desc.x), 0);
+    bool isHazard = traits.type == GameObjectType::Hazard;
+
+    if (m_hazardIndex.size() <= static_cast<size_t>(section)) {
+        m_hazardIndex.resize(section + 1);
+    }
+
+    uint8_t flags = (traits.disabled ? CollisionSection::FlagDisabled : 0) | (isHazard ? CollisionSection::FlagHazard : 0);
+    m_collisionGrid.insert(static_cast<uint32_t>(m_objects.size()), rect, traits.type, flags);
+
+    if (isHazard) {
+        m_hazardIndex.add(section, rect);
+    }
+
+    m_objects.push_back(object);
+}
+
+void Simulation::reset() {
+    for (Object& object : m_objects) {
+        object.activated = false;
+    }
+
+    m_collisionGrid.forEachCell([](auto& cell) {
+        cell.objects.clearActivated();
+    });
+
+    m_physics.setListener(this);
+    m_physics.reset();
+    m_physics.setTouchedRing(GameObjectType::None);
+    m_touchedRing = -1;
+
+    m_physics.flipGravity(false);
+    exitFlyMode();
+    exitRollMode();
+
+    m_x         = m_startX;
+    m_y         = m_startY;
+    m_previousX = m_x;
+    m_previousY = m_y;
+
+    m_clock.setTickRate(m_sweptCollision ? FixedTimestep::SWEPT_TICK_RATE : FixedTimestep::SUBSTEP_TICK_RATE);
+    m_outcome = Outcome::Running;
+
+    m_recording.clear();
+    m_recording.tickRate = static_cast<uint16_t>(m_clock.getTickRate());
+    m_replayCursor       = 0;
+
+    if (m_replay) {
+        m_physics.releaseButton();
+    } else if (m_physics.getButtonPushed()) {
+        m_recording.record(0, true);
+    }
+}
+
+void Simulation::pushButton() {
+    m_recording.record(m_clock.getTick(), true);
+    m_physics.pushButton();
+}
+
+void Simulation::releaseButton() {
+    m_recording.record(m_clock.getTick(), false);
+    m_physics.releaseButton();
+}
+
+void Simulation::applyReplayInput(uint64_t tick) {
+    const auto& events = m_replay->events;
+
+    for (; m_replayCursor < events.size() && events[m_replayCursor].tick <= tick; m_replayCursor++) {
+        if (events[m_replayCursor].press) {
+            pushButton();
+        } else {
+            releaseButton();
+        }
+    }
+}
+
+void Simulation::advance(double seconds) {
+    m_clock.addTime(seconds);
+
+    while (m_outcome == Outcome::Running && m_clock.step()) {
+        if (m_replay) {
+            applyReplayInput(m_clock.getTick() - 1);
+        }
+
+        update(m_clock.getTickDelta());
+
+        if (m_outcome == Outcome::Running && m_x >= m_levelLength) {
+            m_outcome = Outcome::Completed;
+        }
+    }
+
+    m_recording.tickCount = m_clock.getTick();
+}
+
+void Simulation::update(float dt) {
+    if ((m_clock.getTick() - 1) % m_clock.getTicksPerFrame() == 0) {
+        m_physics.setTouchedRing(GameObjectType::None);
+        m_touchedRing = -1;
+    }
+
+    m_previousX = m_x;
+    m_previousY = m_y;
+    m_physics.update(dt, m_x, m_y);
+
+    checkCollisions();
+}
+
+void Simulation::checkCollisions() {
+    if (m_y < 105 && !m_physics.getFlyMode()) {
+        if (m_physics.getGravityFlipped()) {
+            destroyPlayer();
+            return;
+        }
+
+        m_y = 105;
+        m_physics.hitGround();
+    } else if (m_y > 1590) {
+        destroyPlayer();
+        return;
+    }
+
+    if (m_physics.getFlyMode() || m_physics.getRollMode()) {
+        float topBoundary    = m_gameModeGroundPos.top - 15.0f;
+        float bottomBoundary = m_gameModeGroundPos.bottom + 15.0;
+
+        if (m_y > topBoundary) {
+            m_y = topBoundary;
+            m_physics.hitGround();
+        } else if (m_y < bottomBoundary) {
+            m_y = bottomBoundary;
+            m_physics.hitGround();
+        }
+    }
+
+    bool hitHazard = false;
+
+    if (m_sweptCollision) {
+        CollisionRect rect      = getPlayerRect();
+        float deltaX            = m_x - m_previousX;
+        float deltaY            = m_y - m_previousY;
+        CollisionRect startRect = {rect.minX - deltaX, rect.minY - deltaY, rect.maxX - deltaX, rect.maxY - deltaY};
+        hitHazard               = m_objectCollision.collideSwept(m_collisionGrid, m_hazardIndex, startRect, *this);
+    } else {
+        hitHazard = m_objectCollision.collideOverlapping(m_collisionGrid, m_hazardIndex, *this);
+    }
+
+    if (hitHazard) {
+        destroyPlayer();
+    }
+}
+
+void Simulation::onGravityPortal(uint32_t, bool flip) {
+    m_physics.flipGravity(flip);
+}
+
+void Simulation::onShipPortal(uint32_t portal) {
+    switchToFlyMode(m_objects[portal]);
+}
+
+void Simulation::onBallPortal(uint32_t portal) {
+    switchToRollMode(m_objects[portal]);
+}
+
+void Simulation::onCubePortal(uint32_t) {
+    exitFlyMode();
+    exitRollMode();
+}
+
+void Simulation::onMirrorPortal(uint32_t, bool) {
+    // Only flips the view.
+}
+
+void Simulation::onPad(uint32_t, float force, bool gravityFlipped) {
+    m_physics.propellPlayer(force);
+    m_physics.flipGravity(gravityFlipped);
+}
+
+void Simulation::onOrb(uint32_t orb, GameObjectType type) {
+    m_physics.setTouchedRing(type);
+    m_touchedRing = orb;
+    m_physics.ringJump();
+}
+
+void Simulation::onBlock(uint32_t, const CollisionRect& rect) {
+    float snappedY = 0;
+
+    switch (m_physics.collideWithBlock(m_x, m_y, m_previousY, rect, snappedY)) {
+    case PlayerPhysics::BlockContact::Landed:
+        m_y = snappedY;
+        m_physics.hitGround();
+        break;
+    case PlayerPhysics::BlockContact::Crushed:
+        destroyPlayer();
+        break;
+    case PlayerPhysics::BlockContact::None:
+        break;
+    }
+}
+
+void Simulation::destroyPlayer() {
+    if (m_outcome != Outcome::Running) {
+        return;
+    }
+
+    m_outcome = Outcome::Died;
+    m_physics.setIsDead(true);
+}
+
+void Simulation::switchToFlyMode(const Object& portal) {
+    exitRollMode();
+    m_physics.toggleFlyMode(true);
+
+    m_gameModeGroundPos.bottom = portal.y - 150;
+    m_gameModeGroundPos.bottom = std::max(floorf(m_gameModeGroundPos.bottom / 30) * 30, 90.0f);
+    m_gameModeGroundPos.top    = m_gameModeGroundPos.bottom + 300;
+}
+
+void Simulation::switchToRollMode(const Object& portal) {
+    exitFlyMode();
+    toggleRollMode(true);
+
+    m_gameModeGroundPos.bottom = portal.y - 120;
+    m_gameModeGroundPos.bottom = std::max(floorf(m_gameModeGroundPos.bottom / 30) * 30, 90.0f);
+    m_gameModeGroundPos.top    = m_gameModeGroundPos.bottom + 240;
+}
+
+void Simulation::exitFlyMode() {
+    m_physics.toggleFlyMode(false);
+}
+
+void Simulation::exitRollMode() {
+    toggleRollMode(false);
+}
+
+void Simulation::toggleRollMode(bool toggle) {
+    // `PlayerObject::toggleRollMode`
+    if (m_physics.toggleRollMode(toggle)) {
+        m_physics.toggleFlyMode(false);
+    }
+}
+
+int Simulation::sectionForX(float x) const {
+    return static_cast<int>(floorf(x / 100));
+}
+
+void Simulation::onRingJump() {
+    if (m_touchedRing >= 0) {
+        m_objects[m_touchedRing].activated = true;
+        m_touchedRing = -1;
+    }
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+#include "Objects/CollisionSection.h"
+#include "Objects/HazardIndex.h"
+#include "Objects/ObjectCollision.h"
+#include "Objects/ObjectDescriptor.h"
+#include "Objects/PlayerPhysics.h"
+#include "Objects/SpatialGrid.h"
+#include "Utils/FixedTimestep.inl.h"
+#include "Utils/ReplayFormat.inl.h"
+#include "Utils/SpriteSheet.inl.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * `PlayScene` without the engine: the level's hitboxes, the player's physics and the collision rules,
+ * stepped on the same fixed tick as the game.
+ *
+ * The player and the collision rules are the game's own `PlayerPhysics` and `ObjectCollision`, this
+ * only mirrors the rest of `PlayScene::update` and `checkCollisions` (ground, ceiling and game mode
+ * bounds). Everything visual (camera, mirror effect, particles, enter effects, triggers) is left out.
+ *
+ * Hitboxes are sized like `GameObject` does it: the object's sprite frame size from the sprite sheet
+ * (see `loadSpriteSheet`) or the `ObjectTraits` override, scaled by the trait's scale mod. Objects
+ * whose frame isn't in the sheet fall back to 30x30, the size of a block.
+ */
+class Simulation : private PlayerPhysics::Listener, private ObjectCollision<uint32_t>::Host {
+public:
+    enum class Outcome {
+        Running,
+        Died,
+        Completed, ///< Passed the end of the level (last object + 340, like `PlayScene::m_levelSize`).
+    };
+
+    static constexpr float DEFAULT_OBJECT_SIZE = 30.0f;
+
+    /**
+     * Contents of `blocks.json`. Objects with keys that aren't in it are skipped, like the game does.
+     */
+    bool loadObjectDictionary(std::string_view json);
+
+    /**
+     * Contents of `GJ_GameSheet.plist`, for the hitbox sizes. `contentScale` is what the sheet's
+     * texture is scaled by compared to game units, e.g. 2 for the `-hd` sheet. Needs to be loaded
+     * before the level.
+     */
+    bool loadSpriteSheet(std::string_view plist, float contentScale = 1.0f);
+
+    /**
+     * Text (`kS1,...;1,34,2,...;`) or compiled (`.tbl`) level data.
+     */
+    bool loadLevel(std::string_view data);
+
+    /**
+     * Same as `CollisionMode::Swept`, 60 Hz ticks and a swept collision pass. Takes effect on `reset`.
+     */
+    void setSweptCollision(bool swept) { m_sweptCollision = swept; }
+
+    /**
+     * Puts the player back at the start, like `PlayScene::resetLevel`.
+     */
+    void reset();
+
+    /**
+     * One frame of `seconds`, runs as many ticks as fit like `PlayScene::update`. Does nothing once the
+     * run is over.
+     */
+    void advance(double seconds);
+
+    /**
+     * Input is recorded against the current tick, see `getRecording`.
+     */
+    void pushButton();
+    void releaseButton();
+
+    /**
+     * Plays `replay` back on every following run instead of taking input, `nullptr` to stop. The
+     * collision mode has to match the replay's tick rate. Takes effect on `reset`.
+     */
+    void setReplay(const replay_format::Replay* replay) { m_replay = replay; }
+
+    /**
+     * Input of the current run, in the same form `PlayScene` saves it.
+     */
+    const replay_format::Replay& getRecording() const { return m_recording; }
+
+    Outcome getOutcome() const { return m_outcome; }
+    uint64_t getTick() const { return m_clock.getTick(); }
+    int getTickRate() const { return m_clock.getTickRate(); }
+    float getPlayerX() const { return m_x; }
+    float getPlayerY() const { return m_y; }
+    float getLevelLength() const { return m_levelLength; }
+    size_t getObjectCount() const { return m_objects.size(); }
+    const PlayerPhysics& getPhysics() const { return m_physics; }
+
+private:
+    struct Object {
+        float x;
+        float y;
+        float rotation;
+        bool flipY;
+        bool activated;
+    };
+
+    void addObject(const ObjectDescriptor& desc);
+
+    void update(float dt);
+    void applyReplayInput(uint64_t tick);
+    void checkCollisions();
+    void destroyPlayer();
+
+    void switchToFlyMode(const Object& portal);
+    void switchToRollMode(const Object& portal);
+    void exitFlyMode();
+    void exitRollMode();
+    void toggleRollMode(bool toggle);
+
+    int sectionForX(float x) const;
+
+    void onRingJump() override;
+
+    // `ObjectCollision::Host`
+    CollisionRect getPlayerRect() const override { return m_physics.rectAt(m_x, m_y); }
+    bool getGravityFlipped() const override { return m_physics.getGravityFlipped(); }
+    bool isObjectActivated(uint32_t object) const override { return m_objects[object].activated; }
+    void setObjectActivated(uint32_t object) override { m_objects[object].activated = true; }
+    float getObjectRotation(uint32_t object) const override { return m_objects[object].rotation; }
+    bool isObjectFlippedY(uint32_t object) const override { return m_objects[object].flipY; }
+    void onGravityPortal(uint32_t portal, bool flip) override;
+    void onShipPortal(uint32_t portal) override;
+    void onBallPortal(uint32_t portal) override;
+    void onCubePortal(uint32_t portal) override;
+    void onMirrorPortal(uint32_t portal, bool mirrored) override;
+    void onPad(uint32_t pad, float force, bool gravityFlipped) override;
+    void onOrb(uint32_t orb, GameObjectType type) override;
+    void onBlock(uint32_t block, const CollisionRect& rect) override;
+
+private:
+    std::unordered_map<int, std::string> m_keyToFrame;
+    std::unordered_map<std::string, sprite_sheet::FrameSize> m_frameSizes; ///< In game units.
+
+    std::vector<Object> m_objects;
+    SpatialGrid<uint32_t> m_collisionGrid;
+    HazardIndex m_hazardIndex;
+    ObjectCollision<uint32_t> m_objectCollision;
+    bool m_sweptCollision = false;
+
+    PlayerPhysics m_physics;
+    float m_x         = 0;
+    float m_y         = 105;
+    float m_previousX = 0;
+    float m_previousY = 105;
+    float m_startX    = 0;
+    float m_startY    = 105;
+    int64_t m_touchedRing = -1; ///< Object the physics' touched ring belongs to.
+
+    struct {
+        float bottom = 0;
+        float top    = 0;
+    } m_gameModeGroundPos;
+
+    float m_maxObjectXPos = 0;
+    float m_levelLength   = 0;
+
+    FixedTimestep m_clock;
+    replay_format::Replay m_recording;
+    const replay_format::Replay* m_replay = nullptr;
+    size_t m_replayCursor = 0;
+    Outcome m_outcome = Outcome::Running;
+};
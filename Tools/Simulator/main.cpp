@@ -0,0 +1,336 @@
+/**
+ * tombstone-sim: plays a level headlessly, without a window or the engine, and reports how the run
+ * ended and how fast it was simulated.
+ *
+ *     tombstone-sim [--level <file>] [--blocks <file>] [--sheet <file>] [--input <script> | --hold | --replay <file>]
+ *                   [--record <file>] [--dt <seconds>] [--max-time <seconds>] [--runs <n>] [--swept]
+ *
+ * Hitbox sizes come from the sprite sheet plist, `--sheet` or else `GJ_GameSheet-hd.plist` /
+ * `GJ_GameSheet.plist` in Content (the game's files, which aren't part of the repo). A `-hd` or
+ * `-uhd` sheet is scaled down to game units. Without one, objects are 30x30.
+ *
+ * An input script has one `<frame> press|release` per line (`#` starts a comment), frames count 60 Hz
+ * frames from the start of the run and are applied before the first frame that starts at or after
+ * that time. `--hold` keeps the button pressed for the whole run instead.
+ *
+ * `--replay` plays back a `.tbrp` file saved by the game (`last_attempt.tbrp`) or by `--record` on
+ * the exact ticks it was recorded on, the collision mode follows the replay's tick rate. `--record`
+ * saves the input of the run as a replay.
+ *
+ * `--dt` is the length of a rendered frame. Physics runs on a fixed tick either way (see
+ * `FixedTimestep`), so it only changes when inputs get applied, not how the level plays.
+ *
+ * With `--runs` the level is played several times to get a stable speed measurement. Every run has
+ * to end the same way, otherwise the simulation isn't deterministic and the exit code is 2.
+ */
+
+#include "Simulation.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifndef TOMBSTONE_CONTENT_DIR
+#    define TOMBSTONE_CONTENT_DIR "Content"
+#endif
+
+namespace {
+    struct InputEvent {
+        uint64_t frame;
+        bool press;
+    };
+
+    struct RunResult {
+        Simulation::Outcome outcome;
+        uint64_t ticks;
+        float x;
+        float y;
+
+        bool operator==(const RunResult&) const = default;
+    };
+
+    bool writeFile(const std::string& path, const std::string& data) {
+        std::ofstream file(path, std::ios::binary);
+        return file.write(data.data(), static_cast<std::streamsize>(data.size())).good();
+    }
+
+    bool readFile(const std::string& path, std::string& out) {
+        std::ifstream file(path, std::ios::binary);
+
+        if (!file) {
+            return false;
+        }
+
+        std::ostringstream buffer;
+        buffer << file.rdbuf();
+        out = buffer.str();
+        return true;
+    }
+
+    bool parseInputScript(const std::string& script, std::vector<InputEvent>& events) {
+        std::istringstream lines(script);
+        std::string line;
+        int lineNumber = 0;
+
+        while (std::getline(lines, line)) {
+            lineNumber++;
+            line = line.substr(0, line.find('#'));
+
+            std::istringstream fields(line);
+            uint64_t frame;
+            std::string action;
+
+            if (!(fields >> frame)) {
+                if (line.find_first_not_of(" \t\r") == std::string::npos) {
+                    continue;
+                }
+
+                std::fprintf(stderr, "error: input script line %d: expected a frame\n", lineNumber);
+                return false;
+            }
+
+            if (!(fields >> action) || (action != "press" && action != "release")) {
+                std::fprintf(stderr, "error: input script line %d: expected press or release\n", lineNumber);
+                return false;
+            }
+
+            events.push_back({frame, action == "press"});
+        }
+
+        std::stable_sort(events.begin(), events.end(),
+                         [](const InputEvent& lhs, const InputEvent& rhs) { return lhs.frame < rhs.frame; });
+        return true;
+    }
+
+    RunResult play(Simulation& simulation, const std::vector<InputEvent>& events, bool hold, double dt, double maxTime) {
+        simulation.reset();
+
+        if (hold) {
+            simulation.pushButton();
+        }
+
+        size_t nextEvent = 0;
+        uint64_t frames  = 0;
+
+        while (simulation.getOutcome() == Simulation::Outcome::Running && frames * dt < maxTime) {
+            double now = frames * dt;
+
+            for (; nextEvent < events.size() && events[nextEvent].frame / 60.0 <= now + 1e-9; nextEvent++) {
+                if (events[nextEvent].press) {
+                    simulation.pushButton();
+                } else {
+                    simulation.releaseButton();
+                }
+            }
+
+            simulation.advance(dt);
+            frames++;
+        }
+
+        return {simulation.getOutcome(), simulation.getTick(), simulation.getPlayerX(), simulation.getPlayerY()};
+    }
+
+    /**
+     * Same suffixes as `AssetManager::getTextureQualitySuffix`.
+     */
+    float sheetContentScale(std::string_view path) {
+        if (path.find("-uhd.") != std::string_view::npos) {
+            return 4.0f;
+        }
+
+        return (path.find("-hd.") != std::string_view::npos) ? 2.0f : 1.0f;
+    }
+
+    const char* outcomeName(Simulation::Outcome outcome) {
+        switch (outcome) {
+            case Simulation::Outcome::Died:
+                return "died";
+            case Simulation::Outcome::Completed:
+                return "completed";
+            default:
+                return "timed out";
+        }
+    }
+}
+
+static void printUsage(const char* exe) {
+    std::printf("usage: %s [--level <file>] [--blocks <file>] [--sheet <file>] [--input <script> | --hold | --replay <file>]\n"
+                "       %*s [--record <file>] [--dt <seconds>] [--max-time <seconds>] [--runs <n>] [--swept]\n",
+                exe, static_cast<int>(std::string_view(exe).size()), "");
+}
+
+int main(int argc, char** argv) {
+    std::string levelPath  = TOMBSTONE_CONTENT_DIR "/tombstone/level.txt";
+    std::string blocksPath = TOMBSTONE_CONTENT_DIR "/tombstone/blocks.json";
+    std::string sheetPath;
+    std::string inputPath;
+    std::string replayPath;
+    std::string recordPath;
+    bool hold         = false;
+    bool swept        = false;
+    double dt      = 1.0 / 60;
+    double maxTime = 60 * 10;
+    int runs       = 1;
+
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg = argv[i];
+
+        if (arg == "--level" && i + 1 < argc) {
+            levelPath = argv[++i];
+        } else if (arg == "--blocks" && i + 1 < argc) {
+            blocksPath = argv[++i];
+        } else if (arg == "--sheet" && i + 1 < argc) {
+            sheetPath = argv[++i];
+        } else if (arg == "--input" && i + 1 < argc) {
+            inputPath = argv[++i];
+        } else if (arg == "--replay" && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (arg == "--record" && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (arg == "--hold") {
+            hold = true;
+        } else if (arg == "--dt" && i + 1 < argc) {
+            dt = std::atof(argv[++i]);
+        } else if (arg == "--max-time" && i + 1 < argc) {
+            maxTime = std::atof(argv[++i]);
+        } else if (arg == "--runs" && i + 1 < argc) {
+            runs = std::max(std::atoi(argv[++i]), 1);
+        } else if (arg == "--swept") {
+            swept = true;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (dt <= 0) {
+        std::fprintf(stderr, "error: --dt has to be positive\n");
+        return 1;
+    }
+
+    if (!replayPath.empty() && (hold || !inputPath.empty())) {
+        std::fprintf(stderr, "error: --replay can't be combined with --input or --hold\n");
+        return 1;
+    }
+
+    Simulation simulation;
+    std::string buffer;
+
+    if (!readFile(blocksPath, buffer) || !simulation.loadObjectDictionary(buffer)) {
+        std::fprintf(stderr, "error: can't read object dictionary %s\n", blocksPath.c_str());
+        return 1;
+    }
+
+    if (!sheetPath.empty()) {
+        if (!readFile(sheetPath, buffer) || !simulation.loadSpriteSheet(buffer, sheetContentScale(sheetPath))) {
+            std::fprintf(stderr, "error: can't read sprite sheet %s\n", sheetPath.c_str());
+            return 1;
+        }
+    } else {
+        for (const char* path : {TOMBSTONE_CONTENT_DIR "/GJ_GameSheet-hd.plist", TOMBSTONE_CONTENT_DIR "/GJ_GameSheet.plist"}) {
+            if (readFile(path, buffer) && simulation.loadSpriteSheet(buffer, sheetContentScale(path))) {
+                sheetPath = path;
+                break;
+            }
+        }
+
+        if (sheetPath.empty()) {
+            std::fprintf(stderr, "warning: no GJ_GameSheet plist in %s, hitboxes are 30x30\n", TOMBSTONE_CONTENT_DIR);
+        }
+    }
+
+    if (!readFile(levelPath, buffer) || !simulation.loadLevel(buffer)) {
+        std::fprintf(stderr, "error: can't read level %s\n", levelPath.c_str());
+        return 1;
+    }
+
+    std::vector<InputEvent> events;
+
+    if (!inputPath.empty()) {
+        if (!readFile(inputPath, buffer)) {
+            std::fprintf(stderr, "error: can't read input script %s\n", inputPath.c_str());
+            return 1;
+        }
+
+        if (!parseInputScript(buffer, events)) {
+            return 1;
+        }
+    }
+
+    replay_format::Replay replay;
+
+    if (!replayPath.empty()) {
+        if (!readFile(replayPath, buffer) || !replay_format::decode(buffer, replay)) {
+            std::fprintf(stderr, "error: can't read replay %s\n", replayPath.c_str());
+            return 1;
+        }
+
+        if (replay.tickRate == FixedTimestep::SWEPT_TICK_RATE) {
+            swept = true;
+        } else if (replay.tickRate == FixedTimestep::SUBSTEP_TICK_RATE) {
+            swept = false;
+        } else {
+            std::fprintf(stderr, "error: replay %s was recorded at an unknown tick rate (%d Hz)\n",
+                         replayPath.c_str(), replay.tickRate);
+            return 1;
+        }
+
+        simulation.setReplay(&replay);
+    }
+
+    simulation.setSweptCollision(swept);
+
+    using clock = std::chrono::steady_clock;
+
+    RunResult first{};
+    uint64_t totalTicks = 0;
+    bool deterministic  = true;
+
+    auto start = clock::now();
+
+    for (int run = 0; run < runs; run++) {
+        RunResult result = play(simulation, events, hold, dt, maxTime);
+        totalTicks += result.ticks;
+
+        if (run == 0) {
+            first = result;
+        } else if (!(result == first)) {
+            deterministic = false;
+        }
+    }
+
+    double elapsed     = std::chrono::duration<double>(clock::now() - start).count();
+    double ticksPerSec = (elapsed > 0) ? totalTicks / elapsed : 0;
+    int tickRate       = simulation.getTickRate();
+
+    std::printf("level:   %s, %zu objects, %.0f units long\n", levelPath.c_str(), simulation.getObjectCount(),
+                simulation.getLevelLength());
+    std::printf("result:  %s at (%.2f, %.2f) on tick %llu (%.2f s of game time at %d Hz)\n",
+                outcomeName(first.outcome), first.x, first.y, static_cast<unsigned long long>(first.ticks),
+                static_cast<double>(first.ticks) / tickRate, tickRate);
+    std::printf("speed:   %llu ticks in %.3f s over %d run(s), %.0f ticks/s, %.0fx real time\n",
+                static_cast<unsigned long long>(totalTicks), elapsed, runs, ticksPerSec, ticksPerSec / tickRate);
+
+    if (!replayPath.empty()) {
+        std::printf("replay:  %zu events, recorded run went on for %llu ticks\n", replay.events.size(),
+                    static_cast<unsigned long long>(replay.tickCount));
+    }
+
+    if (!recordPath.empty() && !writeFile(recordPath, replay_format::encode(simulation.getRecording()))) {
+        std::fprintf(stderr, "error: can't write replay %s\n", recordPath.c_str());
+        return 1;
+    }
+
+    if (!deterministic) {
+        std::fprintf(stderr, "error: runs ended differently, the simulation isn't deterministic\n");
+        return 2;
+    }
+
+    return 0;
+}